@@ -12,6 +12,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <math.h>
+#include "../../comum/passo_angular.h" /* seno e cosseno por recorrencia */
 
  
 
@@ -123,15 +124,13 @@ int main(void){
     // Preparando dados para enviar a GPU
     int num_vertices = 32;
     coordenadas vertices[num_vertices];
-    float pi = 3.14;
-    float counter = 0;
     float radius = 1.0;
-    float angle = 0.0;
     float x, y;
-    for(int i=0; i < num_vertices; i++){
-	    angle += (2.0*pi)/num_vertices;
-	    x = cos(angle)*radius;
-	    y = sin(angle)*radius;
+    // o primeiro angulo eh um passo, e os proximos sao rotacoes de um passo (sem cos/sin no laco)
+    passo_angular angle = passo_angular_inicia((2.0*PI)/num_vertices, (2.0*PI)/num_vertices);
+    for(int i=0; i < num_vertices; i++, passo_angular_proximo(&angle)){
+	    x = angle.cosseno*radius;
+	    y = angle.seno*radius;
 	    vertices[i].x = x;
 	    vertices[i].y = y;
 	    //printf("%.2f, %.2f\n",x,y);
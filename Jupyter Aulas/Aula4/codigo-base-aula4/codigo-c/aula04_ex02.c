@@ -12,6 +12,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <math.h>
+#include "../../../comum/passo_angular.h" /* seno e cosseno por recorrencia */
 
  
 
@@ -183,6 +184,13 @@ int main(void){
     float sector_step=(M_PI*2)/num_sectors; // # variar de 0 até 2π
     float stack_step=(M_PI)/num_stacks; // # variar de 0 até π
 
+    //# tabelas de seno e cosseno dos angulos de sector (u) e stack (v)
+    //# sao num+1 angulos, o ultimo eh 2π (sector) e π (stack)
+    //# assim nao chamamos sin/cos para cada vertice
+    float sin_u[num_sectors+1], cos_u[num_sectors+1];
+    float sin_v[num_stacks+1], cos_v[num_stacks+1];
+    passo_angular_tabela(num_sectors+1, 0.0, sector_step, sin_u, cos_u);
+    passo_angular_tabela(num_stacks+1, 0.0, stack_step, sin_v, cos_v);
 
 
     //# vamos gerar um conjunto de vertices representantes poligonos
@@ -194,42 +202,28 @@ int main(void){
     int counter = 0;
     for(int i=0; i < num_sectors; i++){
         for(int j=0; j < num_stacks; j++){
-            float u = i * sector_step; // # angulo setor
-            float v = j * stack_step; // # angulo stack
-            
-            float un = 0;  //# angulo do proximo sector
-            if(i+1==num_sectors){
-                un = M_PI*2;
-            }
-            else{
-                un = (i+1)*sector_step;
-            }
-                
-            float vn = 0; //# angulo do proximo stack
-            if(j+1==num_stacks){
-                vn = M_PI;
-            }
-            else{
-                vn = (j+1)*stack_step;
-            }
+            int u = i; // # angulo setor (indice nas tabelas)
+            int v = j; // # angulo stack
+            int un = i+1; //# angulo do proximo sector
+            int vn = j+1; //# angulo do proximo stack
             
             //# verticies do poligono
             // coordenadas de p0, p1, p2 e p3
-            float p0_x = r*sin(v)*cos(u);
-            float p0_y = r*sin(v)*sin(u);
-            float p0_z = r*cos(v);
+            float p0_x = r*sin_v[v]*cos_u[u];
+            float p0_y = r*sin_v[v]*sin_u[u];
+            float p0_z = r*cos_v[v];
 
-            float p1_x = r*sin(vn)*cos(u);
-            float p1_y = r*sin(vn)*sin(u);
-            float p1_z = r*cos(vn);
+            float p1_x = r*sin_v[vn]*cos_u[u];
+            float p1_y = r*sin_v[vn]*sin_u[u];
+            float p1_z = r*cos_v[vn];
 
-            float p2_x = r*sin(v)*cos(un);
-            float p2_y = r*sin(v)*sin(un);
-            float p2_z = r*cos(v);
+            float p2_x = r*sin_v[v]*cos_u[un];
+            float p2_y = r*sin_v[v]*sin_u[un];
+            float p2_z = r*cos_v[v];
 
-            float p3_x = r*sin(vn)*cos(un);
-            float p3_y = r*sin(vn)*sin(un);
-            float p3_z = r*cos(vn);
+            float p3_x = r*sin_v[vn]*cos_u[un];
+            float p3_y = r*sin_v[vn]*sin_u[un];
+            float p3_z = r*cos_v[vn];
 
             // adicionando triangulo 1 (primeira parte do poligono)
             vertices[counter].x = p0_x; vertices[counter].y = p0_y; vertices[counter].z = p0_z; counter++;
@@ -0,0 +1,67 @@
+/* passo_angular.h
+ *
+ * gera seno e cosseno dos angulos inicio, inicio+passo, inicio+2*passo, ...
+ * sem chamar sin()/cos() para cada angulo. Seno e cosseno de inicio e de passo
+ * sao calculados uma vez, e depois cada proximo angulo eh uma rotacao:
+ *   cos(a+d) = cos(a)cos(d) - sin(a)sin(d)
+ *   sin(a+d) = sin(a)cos(d) + cos(a)sin(d)
+ *
+ * A recorrencia eh feita em double, entao o erro apos k passos eh limitado
+ * por cerca de 4*k*DBL_EPSILON (menor que 1e-9 para k < 1 milhao), bem abaixo
+ * da precisao de float usada nos vertices.
+ *
+ * exemplo:
+ *   passo_angular pa = passo_angular_inicia(0.0, (2.0*PI)/num_vertices);
+ *   for(int i=0; i < num_vertices; i++, passo_angular_proximo(&pa)){
+ *       vertices[i].x = pa.cosseno * radius;
+ *       vertices[i].y = pa.seno * radius;
+ *   }
+ *
+ * ou preencher tabelas de seno/cosseno com passo_angular_tabela().
+ */
+
+#ifndef PASSO_ANGULAR_H
+#define PASSO_ANGULAR_H
+
+#include <math.h>
+
+// pi completo (nao truncado como 3.14 ou 3.141592)
+#ifndef PI
+#define PI 3.14159265358979323846
+#endif
+
+typedef struct{
+    double seno, cosseno;               // do angulo atual
+    double passo_seno, passo_cosseno;   // do passo
+} passo_angular;
+
+
+// angulos em radianos
+static inline passo_angular passo_angular_inicia(double inicio, double passo){
+    passo_angular pa;
+    pa.seno = sin(inicio);
+    pa.cosseno = cos(inicio);
+    pa.passo_seno = sin(passo);
+    pa.passo_cosseno = cos(passo);
+    return pa;
+}
+
+
+// rotaciona para o proximo angulo
+static inline void passo_angular_proximo(passo_angular* pa){
+    double c = pa->cosseno*pa->passo_cosseno - pa->seno*pa->passo_seno;
+    pa->seno = pa->seno*pa->passo_cosseno + pa->cosseno*pa->passo_seno;
+    pa->cosseno = c;
+}
+
+
+// preenche seno[k] e cosseno[k] de inicio + k*passo, para k = 0 .. n-1
+static inline void passo_angular_tabela(int n, double inicio, double passo, float* seno, float* cosseno){
+    passo_angular pa = passo_angular_inicia(inicio, passo);
+    for(int k=0; k < n; k++, passo_angular_proximo(&pa)){
+        seno[k] = (float)pa.seno;
+        cosseno[k] = (float)pa.cosseno;
+    }
+}
+
+#endif
@@ -0,0 +1,323 @@
+///////////////////////////////////////////////////////////////////////////////
+// benchHeadless.cpp
+// =================
+// frame-time benchmark and golden-image test of ModelGL::draw() without
+// window and display. It renders the star, the grid and a field of star
+// instances with HeadlessGL (EGL surfaceless + FBO), prints the frame times
+// and saves the last frame into a PPM file. If a golden image is given, it
+// compares the frame with it and returns 1 if they are different.
+//
+// It also counts the heap allocations (operator new) of the frames after the
+// first one, and of reading the star points through ModelGL::getStarPoints().
+// The draw path must not allocate in steady state, so it returns 3 if any.
+//
+// With --trace=file.json, FrameProfiler is enabled during the timed frames.
+// It prints the mean CPU and GPU time of each pass, and writes the events as
+// Chrome trace JSON.
+//
+// usage: benchHeadless [--trace=file.json] [frames] [width] [height] [out.ppm] [golden.ppm]
+//        (default: 100 640 480 frame.ppm)
+//
+// It runs on CPU-only Mesa (llvmpipe), build and run it with;
+// g++ -O2 -I../src benchHeadless.cpp ../src/HeadlessGL.cpp ../src/ModelGL.cpp
+//     ../src/glExtension.cpp ../src/glStateCache.cpp ../src/Matrices.cpp ../src/Star.cpp
+//     ../src/StarArena.cpp ../src/StarContourCache.cpp ../src/Line.cpp ../src/pointKernels.cpp
+//     ../src/cpuFeature.cpp ../src/FrameProfiler.cpp ../src/glTimerQuery.cpp -lEGL -lGL -o benchHeadless
+// LIBGL_ALWAYS_SOFTWARE=1 ./benchHeadless
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include "HeadlessGL.h"     // must be first to get glext.h prototypes
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+#include "FrameProfiler.h"
+#include "ModelGL.h"
+
+// constants
+const int   DEFAULT_FRAMES = 100;
+const int   DEFAULT_WIDTH = 640;
+const int   DEFAULT_HEIGHT = 480;
+const int   INSTANCE_ROWS = 50;             // 50x50 star instances
+const int   PIXEL_TOLERANCE = 2;            // max diff per channel
+const double MAX_DIFF_RATIO = 0.001;        // max ratio of different pixels
+const int   VIEW_POINT_COUNT = 10000;       // star for the point view check
+
+// # of calls of operator new
+static unsigned long long allocationCount = 0;
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// count the allocations of C++ code, the GL driver uses malloc() directly
+///////////////////////////////////////////////////////////////////////////////
+void* operator new(std::size_t size)
+{
+    ++allocationCount;
+    void* ptr = std::malloc(size ? size : 1);
+    if(!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// load binary PPM (P6) into RGB pixels
+///////////////////////////////////////////////////////////////////////////////
+bool loadPpm(const char* fileName, int& width, int& height, std::vector<unsigned char>& rgb)
+{
+    FILE* file = std::fopen(fileName, "rb");
+    if(!file)
+        return false;
+
+    int maxValue = 0;
+    bool ok = std::fscanf(file, "P6 %d %d %d", &width, &height, &maxValue) == 3 && maxValue == 255;
+    if(ok)
+    {
+        std::fgetc(file);   // single whitespace after header
+        rgb.resize((size_t)width * height * 3);
+        ok = std::fread(&rgb[0], 1, rgb.size(), file) == rgb.size();
+    }
+    std::fclose(file);
+    return ok;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// compare the frame with golden image, return true if they match
+///////////////////////////////////////////////////////////////////////////////
+bool compareGolden(HeadlessGL& headless, const char* fileName)
+{
+    int width, height;
+    std::vector<unsigned char> golden;
+    if(!loadPpm(fileName, width, height, golden))
+    {
+        std::printf("cannot load golden image: %s\n", fileName);
+        return false;
+    }
+    if(width != headless.getWidth() || height != headless.getHeight())
+    {
+        std::printf("golden image size mismatch: %dx%d\n", width, height);
+        return false;
+    }
+
+    std::vector<unsigned char> pixels;
+    headless.readPixels(pixels);
+
+    size_t diffCount = 0;
+    const size_t pixelCount = (size_t)width * height;
+    for(size_t i = 0; i < pixelCount; ++i)
+    {
+        for(int c = 0; c < 3; ++c)
+        {
+            if(std::abs(pixels[i * 4 + c] - golden[i * 3 + c]) > PIXEL_TOLERANCE)
+            {
+                ++diffCount;
+                break;
+            }
+        }
+    }
+
+    double ratio = (double)diffCount / pixelCount;
+    std::printf("golden: %zu different pixels (%.4f%%)\n", diffCount, ratio * 100);
+    return ratio <= MAX_DIFF_RATIO;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// print mean time per frame of each pass on CPU and GPU
+///////////////////////////////////////////////////////////////////////////////
+void printPasses(const FrameProfiler& profiler)
+{
+    struct Pass
+    {
+        const char* name;
+        bool gpu;
+        double sum;         // ns
+        unsigned int count;
+    };
+
+    std::vector<ProfileEvent> events;
+    profiler.getEvents(events);
+    std::vector<Pass> passes;
+    for(size_t i = 0; i < events.size(); ++i)
+    {
+        bool gpu = events[i].track == FrameProfiler::TRACK_GPU;
+        size_t j = 0;
+        while(j < passes.size() && (passes[j].gpu != gpu || std::strcmp(passes[j].name, events[i].name) != 0))
+            ++j;
+        if(j == passes.size())
+        {
+            Pass pass = {events[i].name, gpu, 0, 0};
+            passes.push_back(pass);
+        }
+        passes[j].sum += (double)events[i].duration;
+        ++passes[j].count;
+    }
+
+    std::printf("%-10s %4s %8s %10s\n", "pass", "", "count", "mean (ms)");
+    for(size_t i = 0; i < passes.size(); ++i)
+    {
+        std::printf("%-10s %4s %8u %10.4f\n", passes[i].name, passes[i].gpu ? "GPU" : "CPU",
+                    passes[i].count, passes[i].sum / passes[i].count * 1e-6);
+    }
+}
+
+
+
+int main(int argc, char* argv[])
+{
+    // take --trace option out of the positional arguments
+    const char* traceFile = 0;
+    if(argc > 1 && std::strncmp(argv[1], "--trace=", 8) == 0)
+    {
+        traceFile = argv[1] + 8;
+        --argc;
+        ++argv;
+    }
+
+    int frames = (argc > 1) ? std::atoi(argv[1]) : DEFAULT_FRAMES;
+    int width = (argc > 2) ? std::atoi(argv[2]) : DEFAULT_WIDTH;
+    int height = (argc > 3) ? std::atoi(argv[3]) : DEFAULT_HEIGHT;
+    const char* outFile = (argc > 4) ? argv[4] : "frame.ppm";
+    const char* goldenFile = (argc > 5) ? argv[5] : 0;
+    if(frames < 1)
+        frames = 1;
+
+    HeadlessGL headless;
+    if(!headless.createContext(width, height))
+    {
+        std::printf("headless context: %s\n", headless.getErrorMessage().c_str());
+        return 2;
+    }
+    std::printf("renderer: %s\n", headless.getRenderer().c_str());
+
+    ModelGL model;
+    model.init();
+    model.setWindowSize(width, height);
+    model.setStar(5, 5);
+    std::printf("VBO: %d, GLSL: %d, instancing: %d\n", model.isVboSupported(),
+                model.isShaderReady(), model.isInstancingSupported());
+
+    // field of star instances with a few point counts
+    std::vector<StarInstance> instances(INSTANCE_ROWS * INSTANCE_ROWS);
+    for(int i = 0; i < INSTANCE_ROWS; ++i)
+    {
+        for(int j = 0; j < INSTANCE_ROWS; ++j)
+        {
+            StarInstance& instance = instances[i * INSTANCE_ROWS + j];
+            instance.x = (j - INSTANCE_ROWS / 2) * 0.4f;
+            instance.y = (i - INSTANCE_ROWS / 2) * 0.4f;
+            instance.scale = 0.15f;
+            instance.angle = (float)((i * 7 + j * 13) % 72);
+            instance.color[0] = (float)j / INSTANCE_ROWS;
+            instance.color[1] = (float)i / INSTANCE_ROWS;
+            instance.color[2] = 0.5f;
+            instance.color[3] = 0.5f;
+            instance.pointCount = 5 + (i + j) % 4;
+        }
+    }
+    model.setStarInstances(&instances[0], (unsigned int)instances.size());
+
+    // first frame uploads the buffers
+    model.draw();
+    headless.finish();
+
+    FrameProfiler& profiler = FrameProfiler::getInstance();
+    profiler.setEnabled(traceFile != 0);
+
+    std::vector<double> times(frames);
+    unsigned long long drawAllocations = allocationCount;
+    for(int i = 0; i < frames; ++i)
+    {
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        model.draw();
+        headless.finish();
+        std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+        times[i] = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    }
+    drawAllocations = allocationCount - drawAllocations;
+    profiler.setEnabled(false);
+
+    // read the points of a large star as the point list of the dialog does
+    model.setStar(VIEW_POINT_COUNT, 5);
+    model.draw();
+    volatile float lastX = 0;
+    unsigned long long viewAllocations = allocationCount;
+    for(int i = 0; i < frames; ++i)
+    {
+        Star::PointView points = model.getStarPoints();
+        for(unsigned int j = 0; j < points.size(); ++j)
+            lastX = points[j].x;
+        model.draw();
+    }
+    viewAllocations = allocationCount - viewAllocations;
+    (void)lastX;
+    headless.finish();
+    model.setStar(5, 5);
+    model.draw();
+
+    std::sort(times.begin(), times.end());
+    double sum = 0;
+    for(int i = 0; i < frames; ++i)
+        sum += times[i];
+    std::printf("frames: %d, %dx%d, instances: %u\n", frames, width, height, model.getStarInstanceCount());
+    std::printf("frame time (ms): mean %.3f, min %.3f, median %.3f, max %.3f\n",
+                sum / frames, times[0], times[frames / 2], times[frames - 1]);
+    std::printf("allocations: draw %llu, point view of %d-pointed star %llu\n",
+                drawAllocations, VIEW_POINT_COUNT, viewAllocations);
+
+    int result = 0;
+    if(traceFile)
+    {
+        // GPU times of the last frames are recorded by the draws after them
+        printPasses(profiler);
+        std::printf("GPU timer: %s, dropped frames: %u\n", model.getTimerQuery().isSupported() ? "yes" : "no",
+                    model.getTimerQuery().getDroppedFrameCount());
+        if(profiler.writeChromeTrace(traceFile))
+        {
+            std::printf("trace: %s (%llu events)\n", traceFile, profiler.getRecordCount());
+        }
+        else
+        {
+            std::printf("cannot write trace: %s\n", traceFile);
+            result = 2;
+        }
+    }
+
+    if(drawAllocations > 0 || viewAllocations > 0)
+    {
+        std::printf("draw path allocates in steady state\n");
+        result = 3;
+    }
+    if(!headless.saveImage(outFile))
+    {
+        std::printf("save image: %s\n", headless.getErrorMessage().c_str());
+        result = 2;
+    }
+    if(goldenFile && !compareGolden(headless, goldenFile))
+        result = 1;
+
+    model.quit();
+    headless.closeContext();
+    return result;
+}
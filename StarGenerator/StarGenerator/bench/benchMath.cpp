@@ -0,0 +1,511 @@
+///////////////////////////////////////////////////////////////////////////////
+// benchMath.cpp
+// =============
+// microbenchmark for every public operation of Vector2/3/4 and Matrix2/3/4
+// Each operation runs over arrays of DATA_COUNT independent inputs, so the
+// numbers are throughput, not latency. The mutating operations (normalize(),
+// +=, invert(), translate(), ...) work on a copy of the input, the cost of
+// the copy is listed as "copy" of each type to subtract.
+//
+// For each operation, it prints the best of SAMPLE_COUNT samples;
+// ns/op:     nanoseconds per operation
+// Mops/s:    million operations per second
+// cycles/op: TSC cycles per operation (x86 only), TSC runs at the base
+//            frequency, not the actual clock under turbo
+//
+// usage: benchMath [--json] [filter]
+// --json prints the results as JSON for comparing runs by scripts, and
+// filter runs only the operations whose "group::op" name contains it, e.g.
+// benchMath Matrix4::invert
+//
+// It does not depend on OpenGL or Win32, build it with;
+// g++ -O2 -I../src benchMath.cpp ../src/Matrices.cpp ../src/cpuFeature.cpp -o benchMath
+// operator<<() of the classes is not measured, it is for debugging only.
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "Vectors.h"
+#include "Matrices.h"
+#include "cpuFeature.h"
+
+#if defined(CPU_X86) && defined(_MSC_VER)
+#include <intrin.h>         // for __rdtsc(), _ReadWriteBarrier()
+#elif defined(CPU_X86)
+#include <x86intrin.h>      // for __rdtsc()
+#endif
+
+// constants
+const unsigned int DATA_COUNT = 256;        // # of inputs per operation
+const unsigned int SAMPLE_COUNT = 7;        // take the best of samples
+const double MIN_SAMPLE_NS = 2000000;       // min duration of a sample
+
+typedef std::chrono::steady_clock Clock;
+
+// result of an operation
+struct Result
+{
+    std::string group;
+    std::string op;
+    double ns;                              // per op
+    double cycles;                          // per op, 0 if no TSC
+};
+
+// inputs and outputs of the operations
+struct Data
+{
+    Vector2 v2a[DATA_COUNT], v2b[DATA_COUNT], v2Out[DATA_COUNT];
+    Vector3 v3a[DATA_COUNT], v3b[DATA_COUNT], v3Out[DATA_COUNT];
+    Vector4 v4a[DATA_COUNT], v4b[DATA_COUNT], v4Out[DATA_COUNT];
+    Matrix2 m2a[DATA_COUNT], m2b[DATA_COUNT], m2Out[DATA_COUNT];
+    Matrix3 m3a[DATA_COUNT], m3b[DATA_COUNT], m3Out[DATA_COUNT];
+    Matrix4 m4a[DATA_COUNT], m4b[DATA_COUNT], m4Out[DATA_COUNT];
+    Matrix4 m4Euclidean[DATA_COUNT];        // rotate + translate
+    Matrix4 m4Affine[DATA_COUNT];           // scale + rotate + translate
+    Matrix4 m4Projective[DATA_COUNT];       // projection * affine
+    float f[DATA_COUNT * 16];               // float inputs, also used for set()
+    float fOut[DATA_COUNT];
+    bool bOut[DATA_COUNT];
+};
+
+// global vars
+static Data data;
+static std::vector<Result> results;
+static const char* filter = 0;              // run only matching "group::op"
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// force the compiler to store the outputs and to reload the inputs
+///////////////////////////////////////////////////////////////////////////////
+inline void clobberMemory()
+{
+#if defined(_MSC_VER)
+    _ReadWriteBarrier();
+#else
+    asm volatile("" : : : "memory");
+#endif
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return TSC, or 0 if not available
+///////////////////////////////////////////////////////////////////////////////
+inline unsigned long long readCycles()
+{
+#ifdef CPU_X86
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// measure func(i) for i = [0, DATA_COUNT), and add the result
+// It doubles the repeat count until a sample takes MIN_SAMPLE_NS, then keeps
+// the fastest of SAMPLE_COUNT samples.
+///////////////////////////////////////////////////////////////////////////////
+template<typename Func>
+void run(const char* group, const char* op, Func func)
+{
+    std::string name = std::string(group) + "::" + op;
+    if(filter && name.find(filter) == std::string::npos)
+        return;
+
+    unsigned int repeat = 1;
+    double bestNs = 0, bestCycles = 0;
+    for(unsigned int sample = 0; sample < SAMPLE_COUNT; )
+    {
+        Clock::time_point t1 = Clock::now();
+        unsigned long long c1 = readCycles();
+        for(unsigned int r = 0; r < repeat; ++r)
+        {
+            for(unsigned int i = 0; i < DATA_COUNT; ++i)
+                func(i);
+            clobberMemory();
+        }
+        unsigned long long c2 = readCycles();
+        Clock::time_point t2 = Clock::now();
+
+        double ns = std::chrono::duration<double, std::nano>(t2 - t1).count();
+        if(ns < MIN_SAMPLE_NS)
+        {
+            repeat *= 2;    // calibrating, not a sample
+            continue;
+        }
+
+        double ops = (double)repeat * DATA_COUNT;
+        if(sample == 0 || ns / ops < bestNs)
+        {
+            bestNs = ns / ops;
+            bestCycles = (c2 - c1) / ops;
+        }
+        ++sample;
+    }
+
+    Result result;
+    result.group = group;
+    result.op = op;
+    result.ns = bestNs;
+    result.cycles = bestCycles;
+    results.push_back(result);
+}
+
+// run the statements with index i as a benchmark
+#define BENCH(group, op, ...) run(group, op, [&](unsigned int i) { __VA_ARGS__; })
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// fill the inputs with non-degenerate values
+///////////////////////////////////////////////////////////////////////////////
+void initData()
+{
+    Matrix4 projection(1.2f, 0, 0, 0,  0, 1.6f, 0, 0,  0, 0, -1.002f, -1,  0, 0, -0.2f, 0);
+    for(unsigned int i = 0; i < DATA_COUNT; ++i)
+    {
+        float s = std::sin(i * 0.7f);
+        float c = std::cos(i * 0.3f);
+        data.v2a[i].set(1 + s, 2 - c);
+        data.v2b[i].set(c - 3, s + 0.5f);
+        data.v3a[i].set(1 + s, 2 - c, 0.5f + s * c);
+        data.v3b[i].set(c - 3, s + 0.5f, 2 + c);
+        data.v4a[i].set(1 + s, 2 - c, 0.5f + s * c, 1);
+        data.v4b[i].set(c - 3, s + 0.5f, 2 + c, 0.5f);
+
+        data.m2a[i].set(2 + s, c, -c, 2 + s);
+        data.m2b[i].set(1, s, c, 3);
+        data.m3a[i].set(2 + s, c, 0,  -c, 2 + s, 0,  s, c, 1);
+        data.m3b[i].set(1, s, c,  0, 2, s,  c, 0, 3);
+
+        Vector3 axis = data.v3b[i];
+        data.m4Euclidean[i].rotate(i * 1.3f, axis.normalize()).translate(s, c, -5);
+        data.m4Affine[i] = data.m4Euclidean[i];
+        data.m4Affine[i].scale(1 + s * 0.5f, 2, 1 - c * 0.5f);
+        data.m4Projective[i] = projection * data.m4Affine[i];
+        data.m4a[i] = data.m4Affine[i];
+        data.m4b[i] = data.m4Euclidean[i];
+
+        for(int j = 0; j < 16; ++j)
+            data.f[16 * i + j] = 1 + std::sin(i + j * 0.1f) * 0.5f;
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Vector2/3/4
+///////////////////////////////////////////////////////////////////////////////
+void benchVectors()
+{
+    Vector2* a2 = data.v2a; Vector2* b2 = data.v2b; Vector2* out2 = data.v2Out;
+    Vector3* a3 = data.v3a; Vector3* b3 = data.v3b; Vector3* out3 = data.v3Out;
+    Vector4* a4 = data.v4a; Vector4* b4 = data.v4b; Vector4* out4 = data.v4Out;
+    float* f = data.f;
+    float* fOut = data.fOut;
+    bool* bOut = data.bOut;
+
+    BENCH("Vector2", "copy",        out2[i] = a2[i]);
+    BENCH("Vector2", "set",         out2[i].set(f[i], f[i + 1]));
+    BENCH("Vector2", "length",      fOut[i] = a2[i].length());
+    BENCH("Vector2", "distance",    fOut[i] = a2[i].distance(b2[i]));
+    BENCH("Vector2", "normalize",   out2[i] = a2[i]; out2[i].normalize());
+    BENCH("Vector2", "dot",         fOut[i] = a2[i].dot(b2[i]));
+    BENCH("Vector2", "equal",       bOut[i] = a2[i].equal(b2[i], 0.001f));
+    BENCH("Vector2", "operator-()", out2[i] = -a2[i]);
+    BENCH("Vector2", "operator+",   out2[i] = a2[i] + b2[i]);
+    BENCH("Vector2", "operator-",   out2[i] = a2[i] - b2[i]);
+    BENCH("Vector2", "operator+=",  out2[i] = a2[i]; out2[i] += b2[i]);
+    BENCH("Vector2", "operator-=",  out2[i] = a2[i]; out2[i] -= b2[i]);
+    BENCH("Vector2", "operator*(s)", out2[i] = a2[i] * f[i]);
+    BENCH("Vector2", "operator*(v)", out2[i] = a2[i] * b2[i]);
+    BENCH("Vector2", "operator*=(s)", out2[i] = a2[i]; out2[i] *= f[i]);
+    BENCH("Vector2", "operator*=(v)", out2[i] = a2[i]; out2[i] *= b2[i]);
+    BENCH("Vector2", "operator/",   out2[i] = a2[i] / f[i]);
+    BENCH("Vector2", "operator/=",  out2[i] = a2[i]; out2[i] /= f[i]);
+    BENCH("Vector2", "operator==",  bOut[i] = a2[i] == b2[i]);
+    BENCH("Vector2", "operator!=",  bOut[i] = a2[i] != b2[i]);
+    BENCH("Vector2", "operator<",   bOut[i] = a2[i] < b2[i]);
+    BENCH("Vector2", "operator[]",  fOut[i] = a2[i][i & 1]);
+    BENCH("Vector2", "operator[]&", out2[i][i & 1] = f[i]);
+    BENCH("Vector2", "s*v",         out2[i] = f[i] * a2[i]);
+
+    BENCH("Vector3", "copy",        out3[i] = a3[i]);
+    BENCH("Vector3", "set",         out3[i].set(f[i], f[i + 1], f[i + 2]));
+    BENCH("Vector3", "length",      fOut[i] = a3[i].length());
+    BENCH("Vector3", "distance",    fOut[i] = a3[i].distance(b3[i]));
+    BENCH("Vector3", "angle",       fOut[i] = a3[i].angle(b3[i]));
+    BENCH("Vector3", "normalize",   out3[i] = a3[i]; out3[i].normalize());
+    BENCH("Vector3", "dot",         fOut[i] = a3[i].dot(b3[i]));
+    BENCH("Vector3", "cross",       out3[i] = a3[i].cross(b3[i]));
+    BENCH("Vector3", "equal",       bOut[i] = a3[i].equal(b3[i], 0.001f));
+    BENCH("Vector3", "operator-()", out3[i] = -a3[i]);
+    BENCH("Vector3", "operator+",   out3[i] = a3[i] + b3[i]);
+    BENCH("Vector3", "operator-",   out3[i] = a3[i] - b3[i]);
+    BENCH("Vector3", "operator+=",  out3[i] = a3[i]; out3[i] += b3[i]);
+    BENCH("Vector3", "operator-=",  out3[i] = a3[i]; out3[i] -= b3[i]);
+    BENCH("Vector3", "operator*(s)", out3[i] = a3[i] * f[i]);
+    BENCH("Vector3", "operator*(v)", out3[i] = a3[i] * b3[i]);
+    BENCH("Vector3", "operator*=(s)", out3[i] = a3[i]; out3[i] *= f[i]);
+    BENCH("Vector3", "operator*=(v)", out3[i] = a3[i]; out3[i] *= b3[i]);
+    BENCH("Vector3", "operator/",   out3[i] = a3[i] / f[i]);
+    BENCH("Vector3", "operator/=",  out3[i] = a3[i]; out3[i] /= f[i]);
+    BENCH("Vector3", "operator==",  bOut[i] = a3[i] == b3[i]);
+    BENCH("Vector3", "operator!=",  bOut[i] = a3[i] != b3[i]);
+    BENCH("Vector3", "operator<",   bOut[i] = a3[i] < b3[i]);
+    BENCH("Vector3", "operator[]",  fOut[i] = a3[i][i % 3]);
+    BENCH("Vector3", "operator[]&", out3[i][i % 3] = f[i]);
+    BENCH("Vector3", "s*v",         out3[i] = f[i] * a3[i]);
+
+    BENCH("Vector4", "copy",        out4[i] = a4[i]);
+    BENCH("Vector4", "set",         out4[i].set(f[i], f[i + 1], f[i + 2], f[i + 3]));
+    BENCH("Vector4", "length",      fOut[i] = a4[i].length());
+    BENCH("Vector4", "distance",    fOut[i] = a4[i].distance(b4[i]));
+    BENCH("Vector4", "normalize",   out4[i] = a4[i]; out4[i].normalize());
+    BENCH("Vector4", "dot",         fOut[i] = a4[i].dot(b4[i]));
+    BENCH("Vector4", "equal",       bOut[i] = a4[i].equal(b4[i], 0.001f));
+    BENCH("Vector4", "operator-()", out4[i] = -a4[i]);
+    BENCH("Vector4", "operator+",   out4[i] = a4[i] + b4[i]);
+    BENCH("Vector4", "operator-",   out4[i] = a4[i] - b4[i]);
+    BENCH("Vector4", "operator+=",  out4[i] = a4[i]; out4[i] += b4[i]);
+    BENCH("Vector4", "operator-=",  out4[i] = a4[i]; out4[i] -= b4[i]);
+    BENCH("Vector4", "operator*(s)", out4[i] = a4[i] * f[i]);
+    BENCH("Vector4", "operator*(v)", out4[i] = a4[i] * b4[i]);
+    BENCH("Vector4", "operator*=(s)", out4[i] = a4[i]; out4[i] *= f[i]);
+    BENCH("Vector4", "operator*=(v)", out4[i] = a4[i]; out4[i] *= b4[i]);
+    BENCH("Vector4", "operator/",   out4[i] = a4[i] / f[i]);
+    BENCH("Vector4", "operator/=",  out4[i] = a4[i]; out4[i] /= f[i]);
+    BENCH("Vector4", "operator==",  bOut[i] = a4[i] == b4[i]);
+    BENCH("Vector4", "operator!=",  bOut[i] = a4[i] != b4[i]);
+    BENCH("Vector4", "operator<",   bOut[i] = a4[i] < b4[i]);
+    BENCH("Vector4", "operator[]",  fOut[i] = a4[i][i & 3]);
+    BENCH("Vector4", "operator[]&", out4[i][i & 3] = f[i]);
+    BENCH("Vector4", "s*v",         out4[i] = f[i] * a4[i]);
+
+    BENCH("float", "invSqrt",       fOut[i] = invSqrt(f[i]));
+    BENCH("float", "1/sqrtf",       fOut[i] = 1.0f / sqrtf(f[i]));
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Matrix2/3
+///////////////////////////////////////////////////////////////////////////////
+void benchMatrix23()
+{
+    Matrix2* a2 = data.m2a; Matrix2* b2 = data.m2b; Matrix2* out2 = data.m2Out;
+    Matrix3* a3 = data.m3a; Matrix3* b3 = data.m3b; Matrix3* out3 = data.m3Out;
+    Vector2* v2 = data.v2a; Vector2* vOut2 = data.v2Out;
+    Vector3* v3 = data.v3a; Vector3* vOut3 = data.v3Out;
+    float* f = data.f;
+    float* fOut = data.fOut;
+    bool* bOut = data.bOut;
+
+    BENCH("Matrix2", "copy",        out2[i] = a2[i]);
+    BENCH("Matrix2", "Matrix2(src)", out2[i] = Matrix2(&f[i]));
+    BENCH("Matrix2", "set(src)",    out2[i].set(&f[i]));
+    BENCH("Matrix2", "set(4f)",     out2[i].set(f[i], f[i + 1], f[i + 2], f[i + 3]));
+    BENCH("Matrix2", "setRow(src)", out2[i].setRow(i & 1, &f[i]));
+    BENCH("Matrix2", "setRow(v)",   out2[i].setRow(i & 1, v2[i]));
+    BENCH("Matrix2", "setColumn(src)", out2[i].setColumn(i & 1, &f[i]));
+    BENCH("Matrix2", "setColumn(v)", out2[i].setColumn(i & 1, v2[i]));
+    BENCH("Matrix2", "get",         fOut[i] = a2[i].get()[i & 3]);
+    BENCH("Matrix2", "getDeterminant", fOut[i] = a2[i].getDeterminant());
+    BENCH("Matrix2", "getAngle",    fOut[i] = Matrix2::getAngle(a2[i]));
+    BENCH("Matrix2", "identity",    out2[i].identity());
+    BENCH("Matrix2", "transpose",   out2[i] = a2[i]; out2[i].transpose());
+    BENCH("Matrix2", "invert",      out2[i] = a2[i]; out2[i].invert());
+    BENCH("Matrix2", "operator+",   out2[i] = a2[i] + b2[i]);
+    BENCH("Matrix2", "operator-",   out2[i] = a2[i] - b2[i]);
+    BENCH("Matrix2", "operator+=",  out2[i] = a2[i]; out2[i] += b2[i]);
+    BENCH("Matrix2", "operator-=",  out2[i] = a2[i]; out2[i] -= b2[i]);
+    BENCH("Matrix2", "operator*(v)", vOut2[i] = a2[i] * v2[i]);
+    BENCH("Matrix2", "operator*(M)", out2[i] = a2[i] * b2[i]);
+    BENCH("Matrix2", "operator*=",  out2[i] = a2[i]; out2[i] *= b2[i]);
+    BENCH("Matrix2", "operator==",  bOut[i] = a2[i] == b2[i]);
+    BENCH("Matrix2", "operator!=",  bOut[i] = a2[i] != b2[i]);
+    BENCH("Matrix2", "operator[]",  fOut[i] = a2[i][i & 3]);
+    BENCH("Matrix2", "operator[]&", out2[i][i & 3] = f[i]);
+    BENCH("Matrix2", "operator-()", out2[i] = -a2[i]);
+    BENCH("Matrix2", "s*M",         out2[i] = f[i] * a2[i]);
+    BENCH("Matrix2", "v*M",         vOut2[i] = v2[i] * a2[i]);
+
+    BENCH("Matrix3", "copy",        out3[i] = a3[i]);
+    BENCH("Matrix3", "Matrix3(src)", out3[i] = Matrix3(&f[i]));
+    BENCH("Matrix3", "set(src)",    out3[i].set(&f[i]));
+    BENCH("Matrix3", "set(9f)",     out3[i].set(f[i], f[i + 1], f[i + 2], f[i + 3], f[i + 4], f[i + 5], f[i + 6], f[i + 7], f[i + 8]));
+    BENCH("Matrix3", "setRow(src)", out3[i].setRow(i % 3, &f[i]));
+    BENCH("Matrix3", "setRow(v)",   out3[i].setRow(i % 3, v3[i]));
+    BENCH("Matrix3", "setColumn(src)", out3[i].setColumn(i % 3, &f[i]));
+    BENCH("Matrix3", "setColumn(v)", out3[i].setColumn(i % 3, v3[i]));
+    BENCH("Matrix3", "get",         fOut[i] = a3[i].get()[i % 9]);
+    BENCH("Matrix3", "getDeterminant", fOut[i] = a3[i].getDeterminant());
+    BENCH("Matrix3", "getAngle",    vOut3[i] = a3[i].getAngle());
+    BENCH("Matrix3", "identity",    out3[i].identity());
+    BENCH("Matrix3", "transpose",   out3[i] = a3[i]; out3[i].transpose());
+    BENCH("Matrix3", "invert",      out3[i] = a3[i]; out3[i].invert());
+    BENCH("Matrix3", "operator+",   out3[i] = a3[i] + b3[i]);
+    BENCH("Matrix3", "operator-",   out3[i] = a3[i] - b3[i]);
+    BENCH("Matrix3", "operator+=",  out3[i] = a3[i]; out3[i] += b3[i]);
+    BENCH("Matrix3", "operator-=",  out3[i] = a3[i]; out3[i] -= b3[i]);
+    BENCH("Matrix3", "operator*(v)", vOut3[i] = a3[i] * v3[i]);
+    BENCH("Matrix3", "operator*(M)", out3[i] = a3[i] * b3[i]);
+    BENCH("Matrix3", "operator*=",  out3[i] = a3[i]; out3[i] *= b3[i]);
+    BENCH("Matrix3", "operator==",  bOut[i] = a3[i] == b3[i]);
+    BENCH("Matrix3", "operator!=",  bOut[i] = a3[i] != b3[i]);
+    BENCH("Matrix3", "operator[]",  fOut[i] = a3[i][i % 9]);
+    BENCH("Matrix3", "operator[]&", out3[i][i % 9] = f[i]);
+    BENCH("Matrix3", "operator-()", out3[i] = -a3[i]);
+    BENCH("Matrix3", "s*M",         out3[i] = f[i] * a3[i]);
+    BENCH("Matrix3", "v*M",         vOut3[i] = v3[i] * a3[i]);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Matrix4
+///////////////////////////////////////////////////////////////////////////////
+void benchMatrix4()
+{
+    Matrix4* a = data.m4a; Matrix4* b = data.m4b; Matrix4* out = data.m4Out;
+    Matrix4* euclidean = data.m4Euclidean;
+    Matrix4* affine = data.m4Affine;
+    Matrix4* projective = data.m4Projective;
+    Vector3* v3 = data.v3a; Vector3* vOut3 = data.v3Out;
+    Vector4* v4 = data.v4a; Vector4* vOut4 = data.v4Out;
+    float* f = data.f;
+    float* fOut = data.fOut;
+    bool* bOut = data.bOut;
+    Matrix3 m3;
+
+    BENCH("Matrix4", "copy",        out[i] = a[i]);
+    BENCH("Matrix4", "Matrix4(src)", out[i] = Matrix4(&f[i]));
+    BENCH("Matrix4", "set(src)",    out[i].set(&f[i]));
+    BENCH("Matrix4", "set(16f)",    out[i].set(f[i], f[i + 1], f[i + 2], f[i + 3], f[i + 4], f[i + 5], f[i + 6], f[i + 7],
+                                               f[i + 8], f[i + 9], f[i + 10], f[i + 11], f[i + 12], f[i + 13], f[i + 14], f[i + 15]));
+    BENCH("Matrix4", "setRow(src)", out[i].setRow(i & 3, &f[i]));
+    BENCH("Matrix4", "setRow(v4)",  out[i].setRow(i & 3, v4[i]));
+    BENCH("Matrix4", "setRow(v3)",  out[i].setRow(i & 3, v3[i]));
+    BENCH("Matrix4", "setColumn(src)", out[i].setColumn(i & 3, &f[i]));
+    BENCH("Matrix4", "setColumn(v4)", out[i].setColumn(i & 3, v4[i]));
+    BENCH("Matrix4", "setColumn(v3)", out[i].setColumn(i & 3, v3[i]));
+    BENCH("Matrix4", "get",         fOut[i] = a[i].get()[i & 15]);
+    BENCH("Matrix4", "getTranspose", fOut[i] = a[i].getTranspose()[i & 15]);
+    BENCH("Matrix4", "getDeterminant", fOut[i] = a[i].getDeterminant());
+    BENCH("Matrix4", "getRotationMatrix", m3 = a[i].getRotationMatrix(); fOut[i] = m3[i % 9]);
+    BENCH("Matrix4", "getAngle",    vOut3[i] = euclidean[i].getAngle());
+    BENCH("Matrix4", "getKind",     fOut[i] = (float)a[i].getKind());
+    BENCH("Matrix4", "getKind(unknown)", out[i].set(&f[i]); fOut[i] = (float)out[i].getKind());
+    BENCH("Matrix4", "identity",    out[i].identity());
+    BENCH("Matrix4", "transpose",   out[i] = a[i]; out[i].transpose());
+    BENCH("Matrix4", "invert(Euclidean)", out[i] = euclidean[i]; out[i].invert());
+    BENCH("Matrix4", "invert(affine)", out[i] = affine[i]; out[i].invert());
+    BENCH("Matrix4", "invert(projective)", out[i] = projective[i]; out[i].invert());
+    BENCH("Matrix4", "invertEuclidean", out[i] = euclidean[i]; out[i].invertEuclidean());
+    BENCH("Matrix4", "invertAffine", out[i] = affine[i]; out[i].invertAffine());
+    BENCH("Matrix4", "invertProjective", out[i] = projective[i]; out[i].invertProjective());
+    BENCH("Matrix4", "invertGeneral", out[i] = projective[i]; out[i].invertGeneral());
+    BENCH("Matrix4", "translate(3f)", out[i] = a[i]; out[i].translate(f[i], f[i + 1], f[i + 2]));
+    BENCH("Matrix4", "translate(v)", out[i] = a[i]; out[i].translate(v3[i]));
+    BENCH("Matrix4", "rotate(v)",   out[i] = a[i]; out[i].rotate(f[i] * 30, v3[i]));
+    BENCH("Matrix4", "rotate(3f)",  out[i] = a[i]; out[i].rotate(f[i] * 30, f[i + 1], f[i + 2], f[i + 3]));
+    BENCH("Matrix4", "rotateX",     out[i] = a[i]; out[i].rotateX(f[i] * 30));
+    BENCH("Matrix4", "rotateY",     out[i] = a[i]; out[i].rotateY(f[i] * 30));
+    BENCH("Matrix4", "rotateZ",     out[i] = a[i]; out[i].rotateZ(f[i] * 30));
+    BENCH("Matrix4", "scale(s)",    out[i] = a[i]; out[i].scale(f[i]));
+    BENCH("Matrix4", "scale(3f)",   out[i] = a[i]; out[i].scale(f[i], f[i + 1], f[i + 2]));
+    BENCH("Matrix4", "lookAt(3f)",  out[i] = a[i]; out[i].lookAt(f[i], f[i + 1], f[i + 2]));
+    BENCH("Matrix4", "lookAt(6f)",  out[i] = a[i]; out[i].lookAt(f[i], f[i + 1], f[i + 2], 0, 1, 0));
+    BENCH("Matrix4", "lookAt(v)",   out[i] = a[i]; out[i].lookAt(v3[i]));
+    BENCH("Matrix4", "lookAt(v,up)", out[i] = a[i]; out[i].lookAt(v3[i], Vector3(0, 1, 0)));
+    BENCH("Matrix4", "operator+",   out[i] = a[i] + b[i]);
+    BENCH("Matrix4", "operator-",   out[i] = a[i] - b[i]);
+    BENCH("Matrix4", "operator+=",  out[i] = a[i]; out[i] += b[i]);
+    BENCH("Matrix4", "operator-=",  out[i] = a[i]; out[i] -= b[i]);
+    BENCH("Matrix4", "operator*(v4)", vOut4[i] = a[i] * v4[i]);
+    BENCH("Matrix4", "operator*(v3)", vOut3[i] = a[i] * v3[i]);
+    BENCH("Matrix4", "operator*(M)", out[i] = a[i] * b[i]);
+    BENCH("Matrix4", "operator*=",  out[i] = a[i]; out[i] *= b[i]);
+    BENCH("Matrix4", "operator==",  bOut[i] = a[i] == b[i]);
+    BENCH("Matrix4", "operator!=",  bOut[i] = a[i] != b[i]);
+    BENCH("Matrix4", "operator[]",  fOut[i] = a[i][i & 15]);
+    BENCH("Matrix4", "operator[]&", out[i][i & 15] = f[i]);
+    BENCH("Matrix4", "operator-()", out[i] = -a[i]);
+    BENCH("Matrix4", "s*M",         out[i] = f[i] * a[i]);
+    BENCH("Matrix4", "v3*M",        vOut3[i] = v3[i] * a[i]);
+    BENCH("Matrix4", "v4*M",        vOut4[i] = v4[i] * a[i]);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// print the results as a table or JSON
+///////////////////////////////////////////////////////////////////////////////
+void printTable()
+{
+    std::printf("SIMD: %s, %u inputs per op, best of %u samples\n",
+                getSimdLevelName(detectSimdLevel()), DATA_COUNT, SAMPLE_COUNT);
+    std::printf("%-8s %-20s %10s %10s %10s\n", "group", "op", "ns/op", "Mops/s", "cycles/op");
+    for(size_t i = 0; i < results.size(); ++i)
+    {
+        const Result& r = results[i];
+        std::printf("%-8s %-20s %10.3f %10.1f %10.2f\n", r.group.c_str(), r.op.c_str(), r.ns, 1000 / r.ns, r.cycles);
+    }
+}
+
+void printJson()
+{
+    std::printf("{\n");
+    std::printf("  \"benchmark\": \"math\",\n");
+    std::printf("  \"simd\": \"%s\",\n", getSimdLevelName(detectSimdLevel()));
+    std::printf("  \"inputs\": %u,\n", DATA_COUNT);
+    std::printf("  \"samples\": %u,\n", SAMPLE_COUNT);
+    std::printf("  \"results\": [\n");
+    for(size_t i = 0; i < results.size(); ++i)
+    {
+        const Result& r = results[i];
+        std::printf("    {\"group\": \"%s\", \"op\": \"%s\", \"ns_per_op\": %.4f, \"mops_per_sec\": %.2f, \"cycles_per_op\": %.3f}%s\n",
+                    r.group.c_str(), r.op.c_str(), r.ns, 1000 / r.ns, r.cycles, (i + 1 < results.size()) ? "," : "");
+    }
+    std::printf("  ]\n}\n");
+}
+
+
+
+int main(int argc, char* argv[])
+{
+    bool json = false;
+    for(int i = 1; i < argc; ++i)
+    {
+        if(std::strcmp(argv[i], "--json") == 0)
+            json = true;
+        else
+            filter = argv[i];
+    }
+
+    initData();
+    benchVectors();
+    benchMatrix23();
+    benchMatrix4();
+
+    if(json)
+        printJson();
+    else
+        printTable();
+
+    // use the outputs
+    float sum = 0;
+    for(unsigned int i = 0; i < DATA_COUNT; ++i)
+        sum += data.fOut[i] + data.v3Out[i].x + data.m4Out[i][0] + data.bOut[i];
+    return (sum == 12345) ? 1 : 0;
+}
@@ -0,0 +1,449 @@
+///////////////////////////////////////////////////////////////////////////////
+// benchMatrix.cpp
+// ===============
+// benchmark for Matrix4 multiplications
+// It compares the scalar, SSE and AVX kernels of Matrices.h for;
+// 1. M*M latency:    c = c * m, each multiply depends on the previous one
+// 2. M*M throughput: out[i] = a[i] * b[i] for many independent matrices
+// 3. M*v throughput: out[i] = m * v[i] for many Vector4
+// 4. batch transforms of transformKernels.h for 1M points, per kernel level
+//    and with all threads
+// 5. Matrix4::invert() for each kind of matrix, and invertGeneral() for all
+// 6. TRS matrices of 256K instances by Matrix4::scale/rotateZ/translate, and
+//    by buildTransforms() per kernel level and with all threads
+// and checks the results of SIMD kernels against the scalar version.
+//
+// It does not depend on OpenGL or Win32, build it with;
+// g++ -O2 -I../src benchMatrix.cpp ../src/Matrices.cpp ../src/transformKernels.cpp
+//     ../src/WorkPool.cpp ../src/cpuFeature.cpp -pthread -o benchMatrix
+// add -mavx to make Matrix4::operator*() use the AVX kernel.
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include "Matrices.h"
+#include "transformKernels.h"
+#include "WorkPool.h"
+#include "cpuFeature.h"
+
+// constants
+const unsigned int CHAIN_COUNT = 10000000;  // # of dependent multiplies
+const unsigned int MATRIX_COUNT = 1024;     // # of independent matrices
+const unsigned int MATRIX_REPEAT = 10000;
+const unsigned int VECTOR_COUNT = 4096;     // # of vectors
+const unsigned int VECTOR_REPEAT = 5000;
+const unsigned int BATCH_COUNT = 1 << 20;   // # of points for batch transforms
+const unsigned int BATCH_REPEAT = 20;
+const unsigned int INVERT_COUNT = 10000000;
+const unsigned int INSTANCE_COUNT = 1 << 18; // # of instances for TRS matrices
+const unsigned int INSTANCE_REPEAT = 20;
+
+// global vars
+static float sink = 0;                      // prevent optimizing out
+
+typedef std::chrono::steady_clock Clock;
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return ns between 2 time points divided by the count
+///////////////////////////////////////////////////////////////////////////////
+double nsPer(Clock::time_point t1, Clock::time_point t2, double count)
+{
+    return std::chrono::duration<double, std::nano>(t2 - t1).count() / count;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return max difference of 2 float arrays
+///////////////////////////////////////////////////////////////////////////////
+float maxDiff(const std::vector<float>& a, const std::vector<float>& b)
+{
+    float diff = 0;
+    for(size_t i = 0; i < a.size(); ++i)
+        diff = std::max(diff, std::fabs(a[i] - b[i]));
+    return diff;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// M*M and M*v loops for a kernel, return ns per multiply
+// The kernel is a template parameter to be inlined like the operators.
+///////////////////////////////////////////////////////////////////////////////
+template<void (*Multiply)(const float*, const float*, float*)>
+double benchChain(const float* m)
+{
+    alignas(16) float c[16];
+    alignas(16) float t[16];
+    Matrix4 identity;
+    for(int i = 0; i < 16; ++i)
+        c[i] = identity[i];
+
+    Clock::time_point t1 = Clock::now();
+    for(unsigned int i = 0; i < CHAIN_COUNT; i += 2)
+    {
+        Multiply(c, m, t);
+        Multiply(t, m, c);
+    }
+    Clock::time_point t2 = Clock::now();
+    sink += c[0];
+    return nsPer(t1, t2, CHAIN_COUNT);
+}
+
+template<void (*Multiply)(const float*, const float*, float*)>
+double benchMatrices(const std::vector<float>& a, const std::vector<float>& b, std::vector<float>& out)
+{
+    Clock::time_point t1 = Clock::now();
+    for(unsigned int j = 0; j < MATRIX_REPEAT; ++j)
+    {
+        for(unsigned int i = 0; i < MATRIX_COUNT * 16; i += 16)
+            Multiply(&a[i], &b[i], &out[i]);
+        sink += out[j & 15];
+    }
+    Clock::time_point t2 = Clock::now();
+    return nsPer(t1, t2, (double)MATRIX_COUNT * MATRIX_REPEAT);
+}
+
+template<void (*Transform)(const float*, float, float, float, float, float*)>
+double benchVectors(const float* m, const std::vector<float>& v, std::vector<float>& out)
+{
+    Clock::time_point t1 = Clock::now();
+    for(unsigned int j = 0; j < VECTOR_REPEAT; ++j)
+    {
+        for(unsigned int i = 0; i < VECTOR_COUNT * 4; i += 4)
+            Transform(m, v[i], v[i+1], v[i+2], v[i+3], &out[i]);
+        sink += out[j & 15];
+    }
+    Clock::time_point t2 = Clock::now();
+    return nsPer(t1, t2, (double)VECTOR_COUNT * VECTOR_REPEAT);
+}
+
+
+
+#ifdef CPU_X86
+///////////////////////////////////////////////////////////////////////////////
+// same loops compiled for AVX, so the AVX kernel is inlined
+///////////////////////////////////////////////////////////////////////////////
+TARGET_AVX
+double benchChainAvx(const float* m)
+{
+    alignas(16) float c[16];
+    alignas(16) float t[16];
+    Matrix4 identity;
+    for(int i = 0; i < 16; ++i)
+        c[i] = identity[i];
+
+    Clock::time_point t1 = Clock::now();
+    for(unsigned int i = 0; i < CHAIN_COUNT; i += 2)
+    {
+        multiplyMatrix4Avx(c, m, t);
+        multiplyMatrix4Avx(t, m, c);
+    }
+    Clock::time_point t2 = Clock::now();
+    sink += c[0];
+    return nsPer(t1, t2, CHAIN_COUNT);
+}
+
+TARGET_AVX
+double benchMatricesAvx(const std::vector<float>& a, const std::vector<float>& b, std::vector<float>& out)
+{
+    Clock::time_point t1 = Clock::now();
+    for(unsigned int j = 0; j < MATRIX_REPEAT; ++j)
+    {
+        for(unsigned int i = 0; i < MATRIX_COUNT * 16; i += 16)
+            multiplyMatrix4Avx(&a[i], &b[i], &out[i]);
+        sink += out[j & 15];
+    }
+    Clock::time_point t2 = Clock::now();
+    return nsPer(t1, t2, (double)MATRIX_COUNT * MATRIX_REPEAT);
+}
+#endif
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// batch transforms with the current kernel level, print ns per point
+///////////////////////////////////////////////////////////////////////////////
+struct BatchData
+{
+    std::vector<Vector3> points3;
+    std::vector<Vector4> points4;
+    std::vector<float> x, y, z;
+    std::vector<Vector3> out3;
+    std::vector<Vector4> out4;
+    std::vector<float> outX, outY, outZ;
+};
+
+float maxDiff(const Vector3* a, const Vector3* b, unsigned int count)
+{
+    float diff = 0;
+    for(unsigned int i = 0; i < count; ++i)
+        diff = std::max(diff, std::max(std::fabs(a[i].x - b[i].x), std::max(std::fabs(a[i].y - b[i].y), std::fabs(a[i].z - b[i].z))));
+    return diff;
+}
+
+void benchBatch(const char* name, const Matrix4& m, BatchData& data, WorkPool* pool, const BatchData* reference)
+{
+    double ns[5];
+    for(int test = 0; test < 5; ++test)
+    {
+        Clock::time_point t1 = Clock::now();
+        for(unsigned int j = 0; j < BATCH_REPEAT; ++j)
+        {
+            switch(test)
+            {
+            case 0:
+                transformPoints(m, &data.points3[0], &data.out3[0], BATCH_COUNT, pool);
+                break;
+            case 1:
+                projectPoints(m, &data.points3[0], &data.out3[0], BATCH_COUNT, pool);
+                break;
+            case 2:
+                transformPoints(m, &data.points4[0], &data.out4[0], BATCH_COUNT, pool);
+                break;
+            case 3:
+                transformPoints(m, &data.x[0], &data.y[0], &data.z[0], &data.outX[0], &data.outY[0], &data.outZ[0], BATCH_COUNT, pool);
+                break;
+            case 4:
+                projectPoints(m, &data.x[0], &data.y[0], &data.z[0], &data.outX[0], &data.outY[0], &data.outZ[0], BATCH_COUNT, pool);
+                break;
+            }
+        }
+        Clock::time_point t2 = Clock::now();
+        ns[test] = nsPer(t1, t2, (double)BATCH_COUNT * BATCH_REPEAT);
+    }
+
+    // compare the projected points (last tests of AoS and SoA) with reference
+    float diff = 0;
+    if(reference)
+    {
+        diff = maxDiff(&data.out3[0], &reference->out3[0], BATCH_COUNT);
+        diff = std::max(diff, maxDiff(data.outX, reference->outX));
+        diff = std::max(diff, maxDiff(data.outZ, reference->outZ));
+    }
+    std::printf("%10s %8.2f %8.2f %8.2f %8.2f %8.2f %10g\n", name, ns[0], ns[1], ns[2], ns[3], ns[4], diff);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// build TRS matrices of the instances, return ns per matrix
+// pool=0 uses Matrix4 functions one by one.
+///////////////////////////////////////////////////////////////////////////////
+struct InstanceData
+{
+    std::vector<Vector3> positions;
+    std::vector<float> angles;
+    std::vector<float> scales;
+    std::vector<float> matrices;            // 16 floats per instance
+};
+
+double benchBuild(InstanceData& data, WorkPool* pool)
+{
+    Clock::time_point t1 = Clock::now();
+    for(unsigned int j = 0; j < INSTANCE_REPEAT; ++j)
+    {
+        if(pool)
+        {
+            buildTransforms(&data.positions[0], &data.angles[0], &data.scales[0], &data.matrices[0], INSTANCE_COUNT, pool);
+            continue;
+        }
+        for(unsigned int i = 0; i < INSTANCE_COUNT; ++i)
+        {
+            Matrix4 m;
+            m.scale(data.scales[i]).rotateZ(data.angles[i]).translate(data.positions[i]);
+            const float* src = m.get();
+            std::copy(src, src + 16, &data.matrices[16 * i]);
+        }
+    }
+    Clock::time_point t2 = Clock::now();
+    return nsPer(t1, t2, (double)INSTANCE_COUNT * INSTANCE_REPEAT);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return ns per invert() or invertGeneral() of the matrix
+// The inverse of inverse is the original, so the values stay bounded.
+///////////////////////////////////////////////////////////////////////////////
+double benchInvert(const Matrix4& matrix, bool general)
+{
+    Matrix4 m = matrix;
+    Clock::time_point t1 = Clock::now();
+    for(unsigned int i = 0; i < INVERT_COUNT; ++i)
+    {
+        if(general)
+            m.invertGeneral();
+        else
+            m.invert();
+    }
+    Clock::time_point t2 = Clock::now();
+    sink += m[0];
+    return nsPer(t1, t2, INVERT_COUNT);
+}
+
+
+
+int main()
+{
+    // rotation keeps the chain bounded
+    Matrix4 m;
+    m.rotate(1.0f, 0.3f, 0.5f, 0.8f).translate(0.1f, 0.2f, 0.3f);
+
+    std::vector<float> a(MATRIX_COUNT * 16), b(MATRIX_COUNT * 16);
+    std::vector<float> reference(MATRIX_COUNT * 16), out(MATRIX_COUNT * 16);
+    std::vector<float> v(VECTOR_COUNT * 4), vReference(VECTOR_COUNT * 4), vOut(VECTOR_COUNT * 4);
+    for(size_t i = 0; i < a.size(); ++i)
+    {
+        a[i] = std::sin(i * 0.37f);
+        b[i] = std::cos(i * 0.11f);
+    }
+    for(size_t i = 0; i < v.size(); ++i)
+        v[i] = std::sin(i * 0.23f) * 10;
+
+    int level = detectSimdLevel();
+    std::printf("CPU: %s, Matrix4::operator*() uses %s\n", getSimdLevelName(level),
+#if defined(CPU_X86) && defined(__AVX__)
+                "AVX");
+#elif defined(CPU_X86)
+                "SSE");
+#else
+                "scalar");
+#endif
+    std::printf("%8s %14s %14s %14s %10s\n", "kernel", "M*M chain(ns)", "M*M array(ns)", "M*v array(ns)", "max diff");
+
+    double chain = benchChain<multiplyMatrix4Scalar>(m.get());
+    double matrices = benchMatrices<multiplyMatrix4Scalar>(a, b, reference);
+    double vectors = benchVectors<transformVector4Scalar>(m.get(), v, vReference);
+    std::printf("%8s %14.2f %14.2f %14.2f %10s\n", "scalar", chain, matrices, vectors, "-");
+
+#ifdef CPU_X86
+    chain = benchChain<multiplyMatrix4Sse>(m.get());
+    matrices = benchMatrices<multiplyMatrix4Sse>(a, b, out);
+    vectors = benchVectors<transformVector4Sse>(m.get(), v, vOut);
+    std::printf("%8s %14.2f %14.2f %14.2f %10g\n", "SSE", chain, matrices, vectors,
+                std::max(maxDiff(reference, out), maxDiff(vReference, vOut)));
+
+    if(level >= SIMD_AVX2)
+    {
+        chain = benchChainAvx(m.get());
+        matrices = benchMatricesAvx(a, b, out);
+        std::printf("%8s %14.2f %14.2f %14s %10g\n", "AVX", chain, matrices, "-", maxDiff(reference, out));
+    }
+#endif
+
+    // operators, same as one of above
+    Matrix4 c;
+    Clock::time_point t1 = Clock::now();
+    for(unsigned int i = 0; i < CHAIN_COUNT; ++i)
+        c *= m;
+    Clock::time_point t2 = Clock::now();
+    sink += c[0];
+    std::printf("%8s %14.2f\n", "operator", nsPer(t1, t2, CHAIN_COUNT));
+
+    // batch transforms
+    Matrix4 projection(1.2f, 0, 0, 0,  0, 1.6f, 0, 0,  0, 0, -1.002f, -1,  0, 0, -0.2f, 0);
+    Matrix4 mvp = projection * m;
+    BatchData data, batchReference;
+    data.points3.resize(BATCH_COUNT);
+    data.points4.resize(BATCH_COUNT);
+    data.x.resize(BATCH_COUNT);
+    data.y.resize(BATCH_COUNT);
+    data.z.resize(BATCH_COUNT);
+    for(unsigned int i = 0; i < BATCH_COUNT; ++i)
+    {
+        data.points3[i].set(std::sin(i * 0.1f) * 10, std::cos(i * 0.3f) * 10, -20 - (i & 255) * 0.1f);
+        data.points4[i].set(data.points3[i].x, data.points3[i].y, data.points3[i].z, 1);
+        data.x[i] = data.points3[i].x;
+        data.y[i] = data.points3[i].y;
+        data.z[i] = data.points3[i].z;
+    }
+    data.out3.resize(BATCH_COUNT);
+    data.out4.resize(BATCH_COUNT);
+    data.outX.resize(BATCH_COUNT);
+    data.outY.resize(BATCH_COUNT);
+    data.outZ.resize(BATCH_COUNT);
+
+    static const char* KERNEL_NAMES[] = {"scalar", "SSE2", "AVX2"};
+    WorkPool serial(1);
+    std::printf("\nbatch transforms of %u points (ns per point)\n", BATCH_COUNT);
+    std::printf("%10s %8s %8s %8s %8s %8s %10s\n", "kernel", "Vec3", "Vec3/w", "Vec4", "SoA", "SoA/w", "max diff");
+    for(int i = SIMD_SCALAR; i <= level; ++i)
+    {
+        setTransformKernelLevel(i);
+        benchBatch(KERNEL_NAMES[i], mvp, data, &serial, (i == SIMD_SCALAR) ? 0 : &batchReference);
+        if(i == SIMD_SCALAR)
+            batchReference = data;
+    }
+    char name[32];
+    std::snprintf(name, sizeof(name), "%s x%u", KERNEL_NAMES[level], WorkPool::getInstance().getThreadCount());
+    benchBatch(name, mvp, data, &WorkPool::getInstance(), &batchReference);
+
+    // inverse by kind
+    Matrix4 translation, euclidean, affine;
+    translation.translate(1, 2, 3);
+    euclidean.rotateY(30).rotateX(20).translate(1, 2, 3);
+    affine.scale(1, 2, 3).rotateY(30).translate(1, 2, 3);
+    const Matrix4* kinds[] = {&translation, &euclidean, &affine, &mvp};
+    static const char* KIND_NAMES[] = {"translation", "Euclidean", "affine", "projective"};
+    std::printf("\ninverse (ns)\n");
+    std::printf("%12s %10s %14s\n", "kind", "invert()", "invertGeneral()");
+    for(int i = 0; i < 4; ++i)
+        std::printf("%12s %10.2f %14.2f\n", KIND_NAMES[i], benchInvert(*kinds[i], false), benchInvert(*kinds[i], true));
+
+    // TRS matrices, the angles keep growing like an animation
+    InstanceData instances;
+    instances.positions.resize(INSTANCE_COUNT);
+    instances.angles.resize(INSTANCE_COUNT);
+    instances.scales.resize(INSTANCE_COUNT);
+    instances.matrices.resize(16 * INSTANCE_COUNT);
+    for(unsigned int i = 0; i < INSTANCE_COUNT; ++i)
+    {
+        instances.positions[i].set((float)(i & 511), (float)(i >> 9), -0.01f * (i & 15));
+        instances.angles[i] = i * 0.37f - 5000;
+        instances.scales[i] = 0.5f + (i & 7) * 0.25f;
+    }
+    // reference in double precision
+    std::vector<float> buildReference(16 * INSTANCE_COUNT, 0.0f);
+    for(unsigned int i = 0; i < INSTANCE_COUNT; ++i)
+    {
+        double a = std::fmod((double)instances.angles[i], 360.0) * 3.14159265358979323846 / 180;
+        float* r = &buildReference[16 * i];
+        r[0] = (float)(std::cos(a) * instances.scales[i]);
+        r[1] = (float)(std::sin(a) * instances.scales[i]);
+        r[4] = -r[1];
+        r[5] = r[0];
+        r[10] = instances.scales[i];
+        r[12] = instances.positions[i].x;
+        r[13] = instances.positions[i].y;
+        r[14] = instances.positions[i].z;
+        r[15] = 1;
+    }
+    std::printf("\nTRS matrices of %u instances (ns per matrix)\n", INSTANCE_COUNT);
+    std::printf("%10s %8s %10s\n", "kernel", "ns", "max error");
+    double ns = benchBuild(instances, 0);
+    std::printf("%10s %8.2f %10g\n", "Matrix4", ns, maxDiff(instances.matrices, buildReference));
+    for(int i = SIMD_SCALAR; i <= level + 1; ++i)
+    {
+        WorkPool* pool = &serial;
+        const char* kernelName = KERNEL_NAMES[std::min(i, level)];
+        if(i > level)
+        {
+            std::snprintf(name, sizeof(name), "%s x%u", KERNEL_NAMES[level], WorkPool::getInstance().getThreadCount());
+            kernelName = name;
+            pool = &WorkPool::getInstance();
+        }
+        setTransformKernelLevel(std::min(i, level));
+        ns = benchBuild(instances, pool);
+        std::printf("%10s %8.2f %10g\n", kernelName, ns, maxDiff(instances.matrices, buildReference));
+    }
+
+    return (sink == 12345) ? 1 : 0;
+}
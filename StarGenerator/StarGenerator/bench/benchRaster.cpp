@@ -0,0 +1,323 @@
+///////////////////////////////////////////////////////////////////////////////
+// benchRaster.cpp
+// ===============
+// benchmark for the CPU rasterizer (SoftRasterizer)
+// 1. icons: render 64x64 star icons (fill, 3px edges and points) in parallel,
+//    one icon per iteration of WorkPool::parallelFor()
+// 2. poster: render many stars into a 2048x2048 image, tiles in parallel
+// Both double the # of threads up to the # of cores, and print the time and
+// speedup. The last icon and the poster are saved as PPM files.
+// 3. triangles: fill many small stars with fillStarTriangles() into a
+//    2048x2048 image with each kernel of rasterKernels.h, and print the
+//    triangles per second. The output of each kernel is compared with the
+//    scalar one, and a translucent star is checked for double-blended pixels
+//    on the shared edges of the fan.
+// 4. tiles: a line loop across the tile boundaries must be the same as the
+//    one moved by a tile. Build with -D_GLIBCXX_ASSERTIONS to check the
+//    indices of the tile buffers.
+//
+// usage: benchRaster [iconCount] [maxThreads]   (default: 100000, cores)
+//
+// It does not depend on OpenGL or Win32, build it with;
+// g++ -O2 -I../src benchRaster.cpp ../src/SoftRasterizer.cpp ../src/Star.cpp
+//     ../src/StarArena.cpp ../src/StarContourCache.cpp ../src/WorkPool.cpp ../src/Line.cpp
+//     ../src/pointKernels.cpp ../src/rasterKernels.cpp ../src/cpuFeature.cpp
+//     -pthread -o benchRaster
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include "SoftRasterizer.h"
+#include "Star.h"
+#include "WorkPool.h"
+#include "rasterKernels.h"
+#include "cpuFeature.h"
+
+// constants
+const unsigned int DEFAULT_ICON_COUNT = 100000;
+const int ICON_SIZE = 64;
+const int POSTER_SIZE = 2048;
+const int POSTER_STARS = 20000;
+const int TRIANGLE_STARS = 200000;
+const float BG_COLOR[4] = {0, 0, 0, 1};
+const float FILL_COLOR[4] = {0.8f, 0.8f, 0.8f, 1};
+const float EDGE_COLOR[4] = {1, 1, 0, 1};
+const float POINT_COLOR[4] = {0, 1, 0, 1};
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// save RGBA pixels as binary PPM
+///////////////////////////////////////////////////////////////////////////////
+void savePpm(const char* fileName, const std::vector<unsigned char>& pixels, int width, int height)
+{
+    FILE* file = std::fopen(fileName, "wb");
+    if(!file)
+        return;
+
+    std::fprintf(file, "P6\n%d %d\n255\n", width, height);
+    for(size_t i = 0; i < pixels.size(); i += 4)
+        std::fwrite(&pixels[i], 1, 3, file);
+    std::fclose(file);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// render icons with 5 to 12 points, return time in ms
+///////////////////////////////////////////////////////////////////////////////
+double benchIcons(WorkPool& pool, unsigned int iconCount, std::vector<unsigned char>& lastIcon)
+{
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+
+    pool.parallelFor(iconCount, 256, [&](unsigned int begin, unsigned int end)
+    {
+        Star star;
+        SoftRasterizer raster;
+        std::vector<unsigned char> pixels(ICON_SIZE * ICON_SIZE * 4);
+        for(unsigned int i = begin; i < end; ++i)
+        {
+            star.set(5 + i % 8, 5);
+            raster.setFramebuffer(&pixels[0], ICON_SIZE, ICON_SIZE);
+            raster.setTransform(5.5f, ICON_SIZE * 0.5f, ICON_SIZE * 0.5f);
+            raster.clear(BG_COLOR);
+            raster.fillStar(star, FILL_COLOR);
+            raster.drawStarEdges(star, 3, EDGE_COLOR);
+            raster.drawStarPoints(star, 4, POINT_COLOR);
+            raster.flush(&pool);        // nested, runs on this worker
+
+            if(i == iconCount - 1)
+                lastIcon = pixels;
+        }
+    });
+
+    std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// render a poster of many stars, tiles in parallel, return time in ms
+///////////////////////////////////////////////////////////////////////////////
+double benchPoster(WorkPool& pool, std::vector<unsigned char>& pixels)
+{
+    SoftRasterizer raster;
+    raster.setFramebuffer(&pixels[0], POSTER_SIZE, POSTER_SIZE);
+    raster.clear(BG_COLOR);
+
+    // record commands
+    Star star;
+    unsigned int seed = 1;
+    for(int i = 0; i < POSTER_STARS; ++i)
+    {
+        seed = seed * 1664525 + 1013904223;     // LCG
+        star.set(5 + (seed >> 28) % 6, 1);
+        float color[4] = {(seed & 0xff) / 255.0f, ((seed >> 8) & 0xff) / 255.0f, 1, 0.8f};
+        raster.setTransform(4.0f + (seed >> 24) % 16, (float)((seed >> 4) % POSTER_SIZE),
+                            (float)((seed >> 14) % POSTER_SIZE));
+        raster.fillStar(star, color);
+        raster.drawStarEdges(star, 1.5f, EDGE_COLOR);
+    }
+
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    raster.flush(&pool);
+    std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// fill many small stars with triangles, return time in ms of flush()
+///////////////////////////////////////////////////////////////////////////////
+double benchTriangles(WorkPool& pool, std::vector<unsigned char>& pixels, unsigned int& triangleCount)
+{
+    SoftRasterizer raster;
+    raster.setFramebuffer(&pixels[0], POSTER_SIZE, POSTER_SIZE);
+    raster.clear(BG_COLOR);
+
+    // stars of 5 to 10 points, 2 to 9 pixels radius
+    Star stars[6];
+    for(int i = 0; i < 6; ++i)
+        stars[i].set(5 + i, 1);
+
+    triangleCount = 0;
+    unsigned int seed = 7;
+    for(int i = 0; i < TRIANGLE_STARS; ++i)
+    {
+        seed = seed * 1664525 + 1013904223;     // LCG
+        const Star& star = stars[(seed >> 28) % 6];
+        float color[4] = {(seed & 0xff) / 255.0f, ((seed >> 8) & 0xff) / 255.0f, 1, 1};
+        raster.setTransform(2.0f + (seed >> 24) % 8, (float)((seed >> 4) % POSTER_SIZE),
+                            (float)((seed >> 14) % POSTER_SIZE));
+        raster.fillStarTriangles(star, color);
+        triangleCount += (unsigned int)star.getFillIndices().size() / 3;
+    }
+
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    raster.flush(&pool);
+    std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// fill a translucent star over black, return # of pixels that are blended
+// more than once (or not at all inside) on the shared edges of the fan
+///////////////////////////////////////////////////////////////////////////////
+int countSeamPixels(WorkPool& pool)
+{
+    const int size = 256;
+    const float color[4] = {1, 1, 1, 0.5f};
+    std::vector<unsigned char> pixels(size * size * 4);
+
+    Star star;
+    star.set(12, 3);
+    SoftRasterizer raster;
+    raster.setFramebuffer(&pixels[0], size, size);
+    raster.setTransform(size / 11.0f, size * 0.5f + 0.25f, size * 0.5f + 0.25f);
+    raster.clear(BG_COLOR);
+    raster.fillStarTriangles(star, color);
+    raster.flush(&pool);
+
+    // blended once: 128, twice: 191
+    int count = 0;
+    for(size_t i = 0; i < pixels.size(); i += 4)
+    {
+        if(pixels[i] != 0 && pixels[i] != 128)
+            ++count;
+    }
+    return count;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// draw a square line loop at x,y=100..150 (across the tiles at 128), and the
+// same loop moved by a tile to 36..86 (across 64), then return # of pixels
+// that are different between them
+///////////////////////////////////////////////////////////////////////////////
+int countTileLinePixels(WorkPool& pool)
+{
+    const int size = 200;
+    const int shift = SoftRasterizer::TILE_SIZE;
+    std::vector<unsigned char> pixels(size * size * 4);
+    std::vector<unsigned char> shifted(size * size * 4);
+
+    for(int i = 0; i < 2; ++i)
+    {
+        // pixel (x, size - y)
+        float o = (i == 0) ? 100.0f : 100.0f - shift;
+        float y = size - o;
+        Vector2 points[4] = {Vector2(o, y), Vector2(o + 50, y), Vector2(o + 50, y - 50), Vector2(o, y - 50)};
+        SoftRasterizer raster;
+        raster.setFramebuffer(i == 0 ? &pixels[0] : &shifted[0], size, size);
+        raster.setTransform(1, 0, (float)size);
+        raster.clear(BG_COLOR);
+        raster.drawLineLoop(points, 4, 3, EDGE_COLOR);
+        raster.flush(&pool);
+    }
+
+    int count = 0;
+    for(int y = 0; y < size; ++y)
+    {
+        for(int x = 0; x < size; ++x)
+        {
+            int sx = x - shift, sy = y - shift;
+            for(int c = 0; c < 4; ++c)
+            {
+                unsigned char expected = (sx >= 0 && sy >= 0) ? shifted[(sy * size + sx) * 4 + c] : BG_COLOR[c] * 255;
+                if(pixels[(y * size + x) * 4 + c] != expected)
+                {
+                    ++count;
+                    break;
+                }
+            }
+        }
+    }
+    return count;
+}
+
+
+
+int main(int argc, char* argv[])
+{
+    unsigned int iconCount = DEFAULT_ICON_COUNT;
+    unsigned int maxThreads = std::thread::hardware_concurrency();
+    if(argc > 1)
+        iconCount = (unsigned int)std::strtoul(argv[1], 0, 10);
+    if(argc > 2)
+        maxThreads = (unsigned int)std::strtoul(argv[2], 0, 10);
+    if(maxThreads == 0)
+        maxThreads = 1;
+    if(iconCount == 0)
+        iconCount = 1;
+
+    std::vector<unsigned char> icon;
+    std::vector<unsigned char> poster(POSTER_SIZE * POSTER_SIZE * 4);
+
+    std::printf("icons: %u of %dx%d, poster: %d stars in %dx%d\n", iconCount, ICON_SIZE, ICON_SIZE,
+                POSTER_STARS, POSTER_SIZE, POSTER_SIZE);
+    std::printf("%8s %12s %12s %8s %12s %8s\n", "threads", "icons(ms)", "icons/s", "speedup", "poster(ms)", "speedup");
+
+    double baseIcons = 0, basePoster = 0;
+    unsigned int threads = 1;
+    while(true)
+    {
+        WorkPool pool(threads);
+        double iconMs = benchIcons(pool, iconCount, icon);
+        double posterMs = benchPoster(pool, poster);
+        if(threads == 1)
+        {
+            baseIcons = iconMs;
+            basePoster = posterMs;
+        }
+
+        std::printf("%8u %12.2f %12.0f %7.2fx %12.2f %7.2fx\n", threads, iconMs, iconCount / iconMs * 1000,
+                    baseIcons / iconMs, posterMs, basePoster / posterMs);
+
+        if(threads == maxThreads)
+            break;
+        threads = (threads * 2 < maxThreads) ? threads * 2 : maxThreads;
+    }
+
+    // triangle throughput per kernel, all threads
+    static const char* KERNEL_NAMES[] = {"scalar", "SSE2", "AVX2"};
+    std::vector<unsigned char> reference(POSTER_SIZE * POSTER_SIZE * 4);
+    std::vector<unsigned char> triangles(POSTER_SIZE * POSTER_SIZE * 4);
+    WorkPool pool(maxThreads);
+    std::printf("\ntriangles: %d stars in %dx%d, %u threads\n", TRIANGLE_STARS, POSTER_SIZE, POSTER_SIZE, maxThreads);
+    std::printf("%8s %12s %12s %8s %8s\n", "kernel", "time(ms)", "Mtris/s", "speedup", "match");
+
+    double baseTriangles = 0;
+    for(int level = SIMD_SCALAR; level <= detectSimdLevel(); ++level)
+    {
+        setRasterKernelLevel(level);
+        unsigned int triangleCount = 0;
+        benchTriangles(pool, triangles, triangleCount);     // warm up
+        double ms = benchTriangles(pool, triangles, triangleCount);
+        if(level == SIMD_SCALAR)
+        {
+            baseTriangles = ms;
+            reference = triangles;
+        }
+        std::printf("%8s %12.2f %12.2f %7.2fx %8s\n", KERNEL_NAMES[level], ms, triangleCount / ms / 1000,
+                    baseTriangles / ms, (triangles == reference) ? "yes" : "NO");
+    }
+    setRasterKernelLevel(-1);
+    std::printf("seam pixels: %d\n", countSeamPixels(pool));
+    std::printf("tile line pixels: %d\n", countTileLinePixels(pool));
+
+    savePpm("icon.ppm", icon, ICON_SIZE, ICON_SIZE);
+    savePpm("poster.ppm", poster, POSTER_SIZE, POSTER_SIZE);
+    savePpm("triangles.ppm", triangles, POSTER_SIZE, POSTER_SIZE);
+    return 0;
+}
@@ -0,0 +1,147 @@
+///////////////////////////////////////////////////////////////////////////////
+// benchStar.cpp
+// =============
+// benchmark for generating star contours
+// It compares the methods to compute inner points of a star;
+// GENERATE_INTERSECT (line intersection) and GENERATE_CLOSED_FORM,
+// and the scalar/SSE2/AVX2 kernels of setInnerRadius() and roundInt(), and
+// the hit rate of the unit contour cache for a catalog of stars.
+//
+// It does not depend on OpenGL or Win32, build it with;
+// g++ -O2 -I../src benchStar.cpp ../src/Star.cpp ../src/StarArena.cpp ../src/StarContourCache.cpp
+//     ../src/Line.cpp ../src/pointKernels.cpp ../src/cpuFeature.cpp -o benchStar
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "Star.h"
+#include "StarContourCache.h"
+#include "pointKernels.h"
+#include "cpuFeature.h"
+
+// constants
+const unsigned int POINT_COUNTS[] = {5, 8, 16, 64, 256, 1024};
+const unsigned int TOTAL_POINTS = 4000000;  // # of points to generate per test
+const unsigned int KERNEL_STARS = 10000;    // # of 64-pointed stars for kernel test
+const unsigned int KERNEL_REPEAT = 20;
+const unsigned int CATALOG_COUNTS[] = {5, 5, 5, 6, 8, 5, 7, 5};  // a few counts repeat
+const unsigned int CATALOG_STARS = 1000000;
+
+// global vars
+static float sink = 0;                      // prevent optimizing out
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return ns per contour to generate a N-pointed star with the given mode
+///////////////////////////////////////////////////////////////////////////////
+double benchGenerate(unsigned int pointCount, Star::GenerateMode mode)
+{
+    std::vector<Vector2> points(pointCount * 2);
+    unsigned int iteration = TOTAL_POINTS / pointCount;
+
+    std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+    for(unsigned int i = 0; i < iteration; ++i)
+    {
+        float radius = 1.0f + (i & 15);
+        sink += Star::generateContour(pointCount, radius, &points[0], mode);
+        sink += points[1].x;
+    }
+    std::chrono::high_resolution_clock::time_point t2 = std::chrono::high_resolution_clock::now();
+
+    double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count();
+    return ns / iteration;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return ns per point to rescale inner points and to round all points of
+// many stars, with the kernels of given SIMD level
+///////////////////////////////////////////////////////////////////////////////
+void benchKernels(int level, Star::Layout layout, double& scaleNs, double& roundNs)
+{
+    setPointKernelLevel(level);
+
+    std::vector<Star> stars(KERNEL_STARS, Star(64, 100, layout));
+    double points = (double)KERNEL_STARS * 128 * KERNEL_REPEAT;
+    unsigned int i, j;
+
+    std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+    for(j = 0; j < KERNEL_REPEAT; ++j)
+    {
+        for(i = 0; i < KERNEL_STARS; ++i)
+            stars[i].setInnerRadius(20.0f + j);
+    }
+    std::chrono::high_resolution_clock::time_point t2 = std::chrono::high_resolution_clock::now();
+    for(j = 0; j < KERNEL_REPEAT; ++j)
+    {
+        for(i = 0; i < KERNEL_STARS; ++i)
+            stars[i].roundInt();
+    }
+    std::chrono::high_resolution_clock::time_point t3 = std::chrono::high_resolution_clock::now();
+
+    sink += stars[0].getPointsX()[1];
+    scaleNs = std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count() / points;
+    roundNs = std::chrono::duration_cast<std::chrono::nanoseconds>(t3 - t2).count() / points;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+// return ns per Star object built from a catalog of repeated point counts,
+// and the hit rate of the unit contour cache
+///////////////////////////////////////////////////////////////////////////////
+double benchCatalog(double& hitRate)
+{
+    const unsigned int kinds = sizeof(CATALOG_COUNTS) / sizeof(CATALOG_COUNTS[0]);
+    StarContourCache& cache = StarContourCache::getInstance();
+    cache.clear();
+    cache.resetStats();
+
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    for(unsigned int i = 0; i < CATALOG_STARS; ++i)
+    {
+        Star star(CATALOG_COUNTS[i % kinds], 1.0f + (i & 15));
+        sink += star.getInnerRadius();
+    }
+    std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+
+    hitRate = cache.getHitRate();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / CATALOG_STARS;
+}
+
+
+
+int main()
+{
+    std::printf("%8s %16s %16s %8s\n", "points", "intersect(ns)", "closed-form(ns)", "speedup");
+    for(unsigned int i = 0; i < sizeof(POINT_COUNTS) / sizeof(POINT_COUNTS[0]); ++i)
+    {
+        unsigned int n = POINT_COUNTS[i];
+        double t1 = benchGenerate(n, Star::GENERATE_INTERSECT);
+        double t2 = benchGenerate(n, Star::GENERATE_CLOSED_FORM);
+        std::printf("%8u %16.1f %16.1f %7.2fx\n", n, t1, t2, t1 / t2);
+    }
+
+    std::printf("\n%8s %8s %16s %16s\n", "kernel", "layout", "innerRadius(ns)", "roundInt(ns)");
+    for(int level = SIMD_SCALAR; level <= detectSimdLevel(); ++level)
+    {
+        double scaleNs, roundNs;
+        benchKernels(level, Star::LAYOUT_AOS, scaleNs, roundNs);
+        std::printf("%8s %8s %16.3f %16.3f\n", getSimdLevelName(level), "aos", scaleNs, roundNs);
+        benchKernels(level, Star::LAYOUT_SOA, scaleNs, roundNs);
+        std::printf("%8s %8s %16.3f %16.3f\n", getSimdLevelName(level), "soa", scaleNs, roundNs);
+    }
+
+    double hitRate;
+    double catalogNs = benchCatalog(hitRate);
+    std::printf("\ncatalog: %.1f ns/star, contour cache hit rate %.4f\n", catalogNs, hitRate);
+
+    return sink == 12345.0f;    // use the result
+}
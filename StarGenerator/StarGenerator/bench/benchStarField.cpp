@@ -0,0 +1,124 @@
+///////////////////////////////////////////////////////////////////////////////
+// benchStarField.cpp
+// ==================
+// benchmark for generating a star field with multiple threads
+// It generates a catalog of stars (point count, radius and position per star)
+// with StarBatch::generateParallel(), doubling the # of threads up to the #
+// of cores, and prints the scaling curve; time, speedup and efficiency.
+// "warm" reuses the output buffer of the previous run. "cold" frees it before
+// each run, so the time includes the page faults of the new buffer, which
+// are taken by the workers writing their stars.
+//
+// usage: benchStarField [starCount] [maxThreads]   (default: 10000000, cores)
+//
+// It does not depend on OpenGL or Win32, build it with;
+// g++ -O2 -I../src benchStarField.cpp ../src/StarBatch.cpp ../src/Star.cpp
+//     ../src/StarArena.cpp ../src/StarContourCache.cpp ../src/WorkPool.cpp ../src/Line.cpp
+//     ../src/pointKernels.cpp ../src/cpuFeature.cpp -pthread -o benchStarField
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include "StarBatch.h"
+#include "WorkPool.h"
+
+// constants
+const unsigned int DEFAULT_STAR_COUNT = 10000000;
+const unsigned int CATALOG_COUNTS[] = {5, 5, 5, 6, 8, 5, 7, 5};  // a few counts repeat
+const int REPEAT = 3;                       // take the best of 3 runs
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return the best time in ms to generate the catalog with the pool
+// If cold, the output buffer is freed before each run.
+///////////////////////////////////////////////////////////////////////////////
+double benchField(StarBatch& batch, WorkPool& pool, const std::vector<unsigned int>& counts,
+                  const std::vector<float>& radii, const std::vector<Vector2>& positions, bool cold)
+{
+    double best = 0;
+    for(int i = 0; i < REPEAT; ++i)
+    {
+        if(cold)
+            batch.clear();
+
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        batch.generateParallel(&counts[0], &radii[0], 0, &positions[0], (unsigned int)counts.size(), &pool);
+        std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+
+        double ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        if(i == 0 || ms < best)
+            best = ms;
+    }
+    return best;
+}
+
+
+
+int main(int argc, char* argv[])
+{
+    unsigned int starCount = DEFAULT_STAR_COUNT;
+    unsigned int maxThreads = std::thread::hardware_concurrency();
+    if(argc > 1)
+        starCount = (unsigned int)std::strtoul(argv[1], 0, 10);
+    if(argc > 2)
+        maxThreads = (unsigned int)std::strtoul(argv[2], 0, 10);
+    if(maxThreads == 0)
+        maxThreads = 1;
+    if(starCount == 0)
+    {
+        std::printf("usage: benchStarField [starCount] [maxThreads], starCount > 0\n");
+        return 1;
+    }
+
+    // catalog
+    const unsigned int kinds = sizeof(CATALOG_COUNTS) / sizeof(CATALOG_COUNTS[0]);
+    std::vector<unsigned int> counts(starCount);
+    std::vector<float> radii(starCount);
+    std::vector<Vector2> positions(starCount);
+    unsigned int seed = 1;
+    for(unsigned int i = 0; i < starCount; ++i)
+    {
+        seed = seed * 1664525 + 1013904223;     // LCG
+        counts[i] = CATALOG_COUNTS[(seed >> 16) % kinds];
+        radii[i] = 1.0f + (seed >> 24) / 16.0f;
+        positions[i].set((float)(seed & 0xffff), (float)((seed >> 8) & 0xffff));
+    }
+
+    // warm up the contour cache
+    StarBatch batch;
+    batch.generate(&counts[0], &radii[0], 0, starCount);
+
+    std::printf("stars: %u, points: %zu\n", starCount, batch.getTotalPointCount());
+    std::printf("%8s %12s %12s %8s %11s %12s %8s\n", "threads", "warm(ms)", "Mstars/s", "speedup",
+                "efficiency", "cold(ms)", "speedup");
+
+    double baseMs = 0, baseColdMs = 0;
+    unsigned int threads = 1;
+    while(true)
+    {
+        WorkPool pool(threads);
+        double coldMs = benchField(batch, pool, counts, radii, positions, true);
+        double ms = benchField(batch, pool, counts, radii, positions, false);
+        if(threads == 1)
+        {
+            baseMs = ms;
+            baseColdMs = coldMs;
+        }
+
+        std::printf("%8u %12.2f %12.2f %7.2fx %10.1f%% %12.2f %7.2fx\n", threads, ms, starCount / ms / 1000.0,
+                    baseMs / ms, 100.0 * baseMs / ms / threads, coldMs, baseColdMs / coldMs);
+
+        if(threads == maxThreads)
+            break;
+        threads = (threads * 2 < maxThreads) ? threads * 2 : maxThreads;
+    }
+
+    return 0;
+}
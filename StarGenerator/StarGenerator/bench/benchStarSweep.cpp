@@ -0,0 +1,354 @@
+///////////////////////////////////////////////////////////////////////////////
+// benchStarSweep.cpp
+// ==================
+// benchmark harness for the setters of Star over point counts and batch sizes
+// It sweeps the # of outer points N (4 to 10000) and the # of stars in a
+// batch B (1 to 10M), and applies each operation to all stars of the batch;
+// set(N, r), setPointCount(N), setRadius(r), setInnerRadius(r), roundInt()
+// The values alternate between samples (N <-> N+1, r <-> 2r), so every call
+// does the real work.
+//
+// A sample is the time of one pass over the batch. The samples are repeated
+// up to MAX_SAMPLES or CELL_NS, and the percentiles are printed per call
+// (sample time / B), with the overhead of the clock subtracted. B=1 is the
+// latency of a single call, the large batches show the cache effects.
+//
+// The allocations per call are counted by replacing the global operator new,
+// after 2 warm-up passes (the steady state, the contours are cached). The
+// SoA layout (AlignedArray uses aligned malloc) would not be counted, so the
+// benchmark uses the default AoS layout.
+//
+// The batches larger than the memory budget are skipped. The estimate per
+// star is sizeof(Star) plus 2N points.
+//
+// Then it compares the temporary stars of a frame (FRAME_STARS stars built
+// and freed per frame) on the heap and in StarArena.
+//
+// usage: benchStarSweep [maxBatch] [memoryMB]  (default: 10000000, 4096)
+//
+// It does not depend on OpenGL or Win32, build it with;
+// g++ -O2 -I../src benchStarSweep.cpp ../src/Star.cpp ../src/StarArena.cpp
+//     ../src/StarContourCache.cpp ../src/Line.cpp ../src/pointKernels.cpp
+//     ../src/cpuFeature.cpp -o benchStarSweep
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include "Star.h"
+#include "StarArena.h"
+
+// constants
+const unsigned int POINT_COUNTS[] = {4, 5, 8, 16, 64, 256, 1024, 10000};
+const unsigned int BATCH_SIZES[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000};
+const unsigned int MIN_SAMPLES = 5;
+const unsigned int MAX_SAMPLES = 2000;
+const double CELL_NS = 200000000;           // time limit of samples per cell
+const unsigned int DEFAULT_MEMORY_MB = 4096;
+const unsigned int FRAME_POINT_COUNTS[] = {5, 16, 64};
+const unsigned int FRAME_STARS = 100000;
+const unsigned int FRAME_COUNT = 20;
+
+typedef std::chrono::steady_clock Clock;
+
+// operations to measure
+enum Operation
+{
+    OP_SET = 0,
+    OP_SET_POINT_COUNT,
+    OP_SET_RADIUS,
+    OP_SET_INNER_RADIUS,
+    OP_ROUND_INT,
+    OP_COUNT
+};
+static const char* OP_NAMES[] = {"set", "setPointCount", "setRadius", "setInnerRadius", "roundInt"};
+
+// percentiles of ns per call, and allocations per call
+struct Stats
+{
+    double p50, p90, p99, max;
+    double allocs;
+    double bytes;
+    unsigned int samples;
+};
+
+// global vars
+static std::atomic<unsigned long long> allocCount(0);
+static std::atomic<unsigned long long> allocBytes(0);
+static float sink = 0;                      // prevent optimizing out
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// count the allocations of the process
+// All forms of new/delete (array, sized, nothrow) are replaced together, so
+// every new is paired with a delete of this file. They are not inlined, in
+// order not to expose malloc/free to the callers (-Wmismatched-new-delete).
+///////////////////////////////////////////////////////////////////////////////
+#if defined(__GNUC__) || defined(__clang__)
+#define NOINLINE __attribute__((noinline))
+#else
+#define NOINLINE __declspec(noinline)
+#endif
+
+NOINLINE void* countedAlloc(std::size_t size) noexcept
+{
+    allocCount.fetch_add(1, std::memory_order_relaxed);
+    allocBytes.fetch_add(size, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+NOINLINE void countedFree(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+NOINLINE void* operator new(std::size_t size)
+{
+    void* ptr = countedAlloc(size);
+    if(!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+NOINLINE void* operator new[](std::size_t size)
+{
+    void* ptr = countedAlloc(size);
+    if(!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+NOINLINE void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return countedAlloc(size);
+}
+
+NOINLINE void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return countedAlloc(size);
+}
+
+NOINLINE void operator delete(void* ptr) noexcept                               { countedFree(ptr); }
+NOINLINE void operator delete[](void* ptr) noexcept                             { countedFree(ptr); }
+NOINLINE void operator delete(void* ptr, std::size_t) noexcept                  { countedFree(ptr); }
+NOINLINE void operator delete[](void* ptr, std::size_t) noexcept                { countedFree(ptr); }
+NOINLINE void operator delete(void* ptr, const std::nothrow_t&) noexcept        { countedFree(ptr); }
+NOINLINE void operator delete[](void* ptr, const std::nothrow_t&) noexcept      { countedFree(ptr); }
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return the min ns between 2 back-to-back Clock::now()
+///////////////////////////////////////////////////////////////////////////////
+double measureClockOverhead()
+{
+    double best = 1e9;
+    for(int i = 0; i < 1000; ++i)
+    {
+        Clock::time_point t1 = Clock::now();
+        Clock::time_point t2 = Clock::now();
+        best = std::min(best, std::chrono::duration<double, std::nano>(t2 - t1).count());
+    }
+    return best;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// apply the operation to all stars, the values alternate by the sample
+///////////////////////////////////////////////////////////////////////////////
+void applyOperation(Operation op, std::vector<Star>& stars, unsigned int pointCount, unsigned int sample)
+{
+    const unsigned int count = (unsigned int)stars.size();
+    const float radius = (sample & 1) ? 20.0f : 10.0f;
+    switch(op)
+    {
+    case OP_SET:
+        for(unsigned int i = 0; i < count; ++i)
+            stars[i].set(pointCount, radius);
+        break;
+    case OP_SET_POINT_COUNT:
+        for(unsigned int i = 0; i < count; ++i)
+            stars[i].setPointCount(pointCount + (sample & 1));
+        break;
+    case OP_SET_RADIUS:
+        for(unsigned int i = 0; i < count; ++i)
+            stars[i].setRadius(radius);
+        break;
+    case OP_SET_INNER_RADIUS:
+        for(unsigned int i = 0; i < count; ++i)
+            stars[i].setInnerRadius(radius * 0.4f);
+        break;
+    case OP_ROUND_INT:
+        for(unsigned int i = 0; i < count; ++i)
+            stars[i].roundInt();
+        break;
+    default:
+        break;
+    }
+    sink += stars[count - 1].getInnerRadius();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return the value at the percentile of the sorted samples
+///////////////////////////////////////////////////////////////////////////////
+double percentile(const std::vector<double>& sorted, double p)
+{
+    size_t index = (size_t)(p * (sorted.size() - 1) + 0.5);
+    return sorted[index];
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// measure the operation on the batch of stars
+///////////////////////////////////////////////////////////////////////////////
+Stats benchOperation(Operation op, std::vector<Star>& stars, unsigned int pointCount, double clockOverhead)
+{
+    // warm up, the contours of N and N+1 are cached and the storage is grown
+    applyOperation(op, stars, pointCount, 0);
+    applyOperation(op, stars, pointCount, 1);
+
+    std::vector<double> samples;
+    samples.reserve(MAX_SAMPLES);
+    const double batch = (double)stars.size();
+    double total = 0;
+    unsigned long long allocs = allocCount.load();
+    unsigned long long bytes = allocBytes.load();
+
+    while(samples.size() < MAX_SAMPLES && (samples.size() < MIN_SAMPLES || total < CELL_NS))
+    {
+        Clock::time_point t1 = Clock::now();
+        applyOperation(op, stars, pointCount, (unsigned int)samples.size());
+        Clock::time_point t2 = Clock::now();
+
+        double ns = std::chrono::duration<double, std::nano>(t2 - t1).count();
+        total += ns;
+        samples.push_back(std::max(ns - clockOverhead, 0.0) / batch);
+    }
+
+    Stats stats;
+    stats.samples = (unsigned int)samples.size();
+    stats.allocs = (allocCount.load() - allocs) / (batch * stats.samples);
+    stats.bytes = (allocBytes.load() - bytes) / (batch * stats.samples);
+    std::sort(samples.begin(), samples.end());
+    stats.p50 = percentile(samples, 0.50);
+    stats.p90 = percentile(samples, 0.90);
+    stats.p99 = percentile(samples, 0.99);
+    stats.max = samples.back();
+    return stats;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// build and free the temporary stars of frames, on the heap or in the arena
+// It returns ns per star, and the allocations per star.
+///////////////////////////////////////////////////////////////////////////////
+double benchFrames(unsigned int pointCount, StarArena* arena, double& allocs)
+{
+    std::vector<Star> heapStars;
+    heapStars.reserve(FRAME_STARS);
+
+    // warm up the blocks of arena and the contour cache
+    if(arena)
+    {
+        for(unsigned int i = 0; i < FRAME_STARS; ++i)
+            arena->createStar(pointCount, 1.0f + (i & 15));
+        arena->reset();
+    }
+
+    unsigned long long count = allocCount.load();
+    Clock::time_point t1 = Clock::now();
+    for(unsigned int frame = 0; frame < FRAME_COUNT; ++frame)
+    {
+        if(arena)
+        {
+            for(unsigned int i = 0; i < FRAME_STARS; ++i)
+                sink += arena->createStar(pointCount, 1.0f + (i & 15))->getInnerRadius();
+            arena->reset();
+        }
+        else
+        {
+            for(unsigned int i = 0; i < FRAME_STARS; ++i)
+            {
+                heapStars.push_back(Star(pointCount, 1.0f + (i & 15)));
+                sink += heapStars.back().getInnerRadius();
+            }
+            heapStars.clear();
+        }
+    }
+    Clock::time_point t2 = Clock::now();
+
+    double stars = (double)FRAME_STARS * FRAME_COUNT;
+    allocs = (allocCount.load() - count) / stars;
+    return std::chrono::duration<double, std::nano>(t2 - t1).count() / stars;
+}
+
+
+
+int main(int argc, char* argv[])
+{
+    unsigned int maxBatch = BATCH_SIZES[sizeof(BATCH_SIZES) / sizeof(BATCH_SIZES[0]) - 1];
+    unsigned int memoryMB = DEFAULT_MEMORY_MB;
+    if(argc > 1)
+        maxBatch = (unsigned int)std::strtoul(argv[1], 0, 10);
+    if(argc > 2)
+        memoryMB = (unsigned int)std::strtoul(argv[2], 0, 10);
+
+    double clockOverhead = measureClockOverhead();
+    std::printf("sizeof(Star): %u bytes, clock overhead: %.1f ns (subtracted), memory budget: %u MB\n",
+                (unsigned int)sizeof(Star), clockOverhead, memoryMB);
+    std::printf("%-15s %6s %9s %10s %10s %10s %10s %10s %9s %9s\n", "op", "N", "batch",
+                "p50(ns)", "p90(ns)", "p99(ns)", "max(ns)", "Mcalls/s", "allocs", "bytes");
+
+    for(size_t i = 0; i < sizeof(POINT_COUNTS) / sizeof(POINT_COUNTS[0]); ++i)
+    {
+        unsigned int n = POINT_COUNTS[i];
+        for(size_t j = 0; j < sizeof(BATCH_SIZES) / sizeof(BATCH_SIZES[0]); ++j)
+        {
+            unsigned int batch = BATCH_SIZES[j];
+            if(batch > maxBatch)
+                break;
+
+            double starBytes = sizeof(Star) + 2.0 * (n + 1) * sizeof(Vector2);
+            if(starBytes * batch > memoryMB * 1048576.0)
+            {
+                std::printf("%-15s %6u %9u   skipped, needs %.0f MB\n", "-", n, batch, starBytes * batch / 1048576);
+                continue;
+            }
+
+            std::vector<Star> stars(batch, Star(n, 10));
+            for(int op = 0; op < OP_COUNT; ++op)
+            {
+                Stats s = benchOperation((Operation)op, stars, n, clockOverhead);
+                std::printf("%-15s %6u %9u %10.1f %10.1f %10.1f %10.1f %10.2f %9.3f %9.1f\n",
+                            OP_NAMES[op], n, batch, s.p50, s.p90, s.p99, s.max,
+                            (s.p50 > 0) ? 1000 / s.p50 : 0.0, s.allocs, s.bytes);
+            }
+        }
+    }
+
+    std::printf("\ntemporary stars, %u per frame (ns and allocations per star)\n", FRAME_STARS);
+    std::printf("%6s %10s %10s %10s %10s\n", "N", "heap(ns)", "allocs", "arena(ns)", "allocs");
+    for(size_t i = 0; i < sizeof(FRAME_POINT_COUNTS) / sizeof(FRAME_POINT_COUNTS[0]); ++i)
+    {
+        StarArena arena;
+        double heapAllocs, arenaAllocs;
+        double heapNs = benchFrames(FRAME_POINT_COUNTS[i], 0, heapAllocs);
+        double arenaNs = benchFrames(FRAME_POINT_COUNTS[i], &arena, arenaAllocs);
+        std::printf("%6u %10.1f %10.3f %10.1f %10.3f\n", FRAME_POINT_COUNTS[i], heapNs, heapAllocs, arenaNs, arenaAllocs);
+    }
+
+    return (sink == 12345) ? 1 : 0;
+}
@@ -10,17 +10,21 @@
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gamil.com)
 // CREATED: 2016-02-17
-// UPDATED: 2016-02-24
+// UPDATED: 2026-10-18
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <process.h>                                // for _beginthreadex()
 #include <string>
 #include <sstream>
 #include "ControllerGL.h"
+#include "FrameProfiler.h"
 #include "wcharUtil.h"
 #include "Log.h"
 using namespace Win;
 
+// constants
+const char* TRACE_FILE = "frame_trace.json";
+
 
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -89,6 +93,9 @@ int ControllerGL::create()
     else
         Win::log(L"[ERROR] Failed to initialize VBO.");
 
+    if(model->getTimerQuery().isSupported())
+        Win::log("Use GL_ARB_timer_query extension for GPU times of the passes (F12).");
+
     return 0;
 }
 
@@ -99,8 +106,12 @@ int ControllerGL::create()
 ///////////////////////////////////////////////////////////////////////////////
 int ControllerGL::paint()
 {
+    ScopedTimer timer("frame");
+
     // redraw
     model->draw();
+
+    ScopedTimer swapTimer("swap");
     view->swapBuffers();
     return 0;
 }
@@ -270,3 +281,33 @@ int ControllerGL::size(int w, int h, WPARAM wParam)
     Win::log(L"Changed OpenGL rendering window size: %dx%d.", w, h);
     return 0;
 }
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// handle WM_KEYDOWN
+// F12 toggles the profiler, and writes the trace when it is stopped.
+///////////////////////////////////////////////////////////////////////////////
+int ControllerGL::keyDown(int key, LPARAM lParam)
+{
+    if(key != VK_F12)
+        return 0;
+
+    FrameProfiler& profiler = FrameProfiler::getInstance();
+    if(!profiler.isEnabled())
+    {
+        profiler.clear();
+        profiler.setEnabled(true);
+        Win::log("Started frame profiler.");
+    }
+    else
+    {
+        profiler.setEnabled(false);
+        if(profiler.writeChromeTrace(TRACE_FILE))
+            Win::log("Stopped frame profiler, wrote %s (%llu events, %u GPU frames dropped).", TRACE_FILE,
+                     profiler.getRecordCount(), model->getTimerQuery().getDroppedFrameCount());
+        else
+            Win::log("[ERROR] Failed to write %s.", TRACE_FILE);
+    }
+    return 0;
+}
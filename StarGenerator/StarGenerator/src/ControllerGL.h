@@ -8,9 +8,12 @@
 // When this class is constructed, it gets the pointers to model and view
 // components.
 //
+// F12 starts/stops FrameProfiler. When it stops, the recorded CPU and GPU
+// times of the frames are written into TRACE_FILE as Chrome trace JSON.
+//
 //  AUTHOR: Song Ho Ahn (song.ahn@gamil.com)
 // CREATED: 2016-02-17
-// UPDATED: 2016-02-17
+// UPDATED: 2026-10-18
 ///////////////////////////////////////////////////////////////////////////////
 
 #ifndef WIN_CONTROLLER_GL_H
@@ -42,6 +45,7 @@ namespace Win
         int mouseLeave();                           // for WM_MOUSELEAVE
         int mouseWheel(int state, int delta, int x, int y); // for WM_MOUSEWHEEL:state, delta, x, y
         int size(int w, int h, WPARAM wParam);      // for WM_SIZE: width, height, type(SIZE_MAXIMIZED...)
+        int keyDown(int key, LPARAM lParam);        // for WM_KEYDOWN: keyCode, detailInfo
 
     private:
         ModelGL* model;                             // pointer to model component
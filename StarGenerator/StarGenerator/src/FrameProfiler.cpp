@@ -0,0 +1,216 @@
+///////////////////////////////////////////////////////////////////////////////
+// FrameProfiler.cpp
+// =================
+// recorder of timed events per frame, dumped as Chrome trace JSON
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include "FrameProfiler.h"
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor/dtor
+///////////////////////////////////////////////////////////////////////////////
+FrameProfiler::FrameProfiler(unsigned int capacity) : capacity(1), writeIndex(0), frame(0),
+                                                      enabled(false)
+{
+    while(this->capacity < capacity)
+        this->capacity <<= 1;
+    mask = this->capacity - 1;
+
+    slots.reset(new Slot[this->capacity]);
+    for(unsigned int i = 0; i < this->capacity; ++i)
+        slots[i].sequence.store(0, std::memory_order_relaxed);
+
+    origin = std::chrono::steady_clock::now();
+}
+
+FrameProfiler::~FrameProfiler()
+{
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// shared profiler
+///////////////////////////////////////////////////////////////////////////////
+FrameProfiler& FrameProfiler::getInstance()
+{
+    static FrameProfiler profiler;
+    return profiler;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ns since the profiler is created
+///////////////////////////////////////////////////////////////////////////////
+unsigned long long FrameProfiler::now() const
+{
+    return (unsigned long long)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - origin).count();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// claim the next slot, and write the event between 2 sequence numbers
+// The odd sequence tells the reader that the slot is being written.
+///////////////////////////////////////////////////////////////////////////////
+void FrameProfiler::record(const char* name, unsigned long long start, unsigned long long end,
+                           unsigned int track, unsigned int frame)
+{
+    unsigned long long index = writeIndex.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = slots[(unsigned int)index & mask];
+
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.start.store(start, std::memory_order_relaxed);
+    slot.duration.store(end > start ? end - start : 0, std::memory_order_relaxed);
+    slot.frame.store(frame, std::memory_order_relaxed);
+    slot.track.store(track, std::memory_order_relaxed);
+
+    slot.sequence.store(2 * index + 2, std::memory_order_release);
+}
+
+void FrameProfiler::record(const char* name, unsigned long long start, unsigned long long end,
+                           unsigned int track)
+{
+    record(name, start, end, track, getFrame());
+}
+
+void FrameProfiler::record(const char* name, unsigned long long start, unsigned long long end)
+{
+    record(name, start, end, getThreadTrack(), getFrame());
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// copy the last events, skip the slots being written or overwritten
+///////////////////////////////////////////////////////////////////////////////
+unsigned int FrameProfiler::getEvents(std::vector<ProfileEvent>& events) const
+{
+    events.clear();
+    unsigned long long last = writeIndex.load(std::memory_order_acquire);
+    unsigned long long first = (last > capacity) ? last - capacity : 0;
+    events.reserve((size_t)(last - first));
+
+    for(unsigned long long i = first; i < last; ++i)
+    {
+        const Slot& slot = slots[(unsigned int)i & mask];
+        unsigned long long sequence = slot.sequence.load(std::memory_order_acquire);
+        if(sequence != 2 * i + 2)
+            continue;
+
+        ProfileEvent event;
+        event.name = slot.name.load(std::memory_order_relaxed);
+        event.start = slot.start.load(std::memory_order_relaxed);
+        event.duration = slot.duration.load(std::memory_order_relaxed);
+        event.frame = slot.frame.load(std::memory_order_relaxed);
+        event.track = slot.track.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if(slot.sequence.load(std::memory_order_relaxed) != sequence)
+            continue;
+        events.push_back(event);
+    }
+    return (unsigned int)events.size();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// drop all events
+///////////////////////////////////////////////////////////////////////////////
+void FrameProfiler::clear()
+{
+    for(unsigned int i = 0; i < capacity; ++i)
+        slots[i].sequence.store(0, std::memory_order_relaxed);
+    writeIndex.store(0, std::memory_order_release);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// events as complete events ("ph":"X") in microseconds, the frame number in
+// args, and the name of each track as metadata
+///////////////////////////////////////////////////////////////////////////////
+std::string FrameProfiler::toChromeTrace() const
+{
+    std::vector<ProfileEvent> events;
+    getEvents(events);
+
+    std::string json = "{\"traceEvents\":[\n";
+    char buffer[256];
+    std::set<unsigned int> tracks;
+    for(size_t i = 0; i < events.size(); ++i)
+    {
+        const ProfileEvent& event = events[i];
+        tracks.insert(event.track);
+
+        // names are literals of the code, only quotes and backslashes are escaped
+        std::string name;
+        for(const char* c = event.name; c && *c; ++c)
+        {
+            if(*c == '"' || *c == '\\')
+                name += '\\';
+            name += *c;
+        }
+
+        std::snprintf(buffer, sizeof(buffer),
+                      "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+                      "\"pid\":1,\"tid\":%u,\"args\":{\"frame\":%u}},\n",
+                      name.c_str(), event.track == TRACK_GPU ? "gpu" : "cpu",
+                      event.start * 0.001, event.duration * 0.001, event.track, event.frame);
+        json += buffer;
+    }
+
+    for(std::set<unsigned int>::const_iterator it = tracks.begin(); it != tracks.end(); ++it)
+    {
+        if(*it == TRACK_GPU)
+            std::snprintf(buffer, sizeof(buffer), "GPU");
+        else
+            std::snprintf(buffer, sizeof(buffer), "CPU thread %u", *it);
+        json += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":";
+        json += std::to_string(*it);
+        json += ",\"args\":{\"name\":\"";
+        json += buffer;
+        json += "\"}},\n";
+    }
+
+    json += "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"StarGenerator\"}}\n";
+    json += "],\"displayTimeUnit\":\"ms\"}\n";
+    return json;
+}
+
+bool FrameProfiler::writeChromeTrace(const char* fileName) const
+{
+    std::ofstream file(fileName, std::ios::out | std::ios::binary);
+    if(!file)
+        return false;
+    file << toChromeTrace();
+    return (bool)file;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// track of the calling thread, 1 for the first thread that records
+///////////////////////////////////////////////////////////////////////////////
+unsigned int FrameProfiler::getThreadTrack()
+{
+    static std::atomic<unsigned int> nextTrack(TRACK_GPU + 1);
+    thread_local unsigned int track = 0;
+    if(track == 0)
+        track = nextTrack.fetch_add(1, std::memory_order_relaxed);
+    return track;
+}
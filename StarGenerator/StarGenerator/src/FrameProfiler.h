@@ -0,0 +1,148 @@
+///////////////////////////////////////////////////////////////////////////////
+// FrameProfiler.h
+// ===============
+// recorder of timed events per frame, dumped as Chrome trace JSON
+// An event is a named span [start, start+duration) in nanoseconds since the
+// profiler is created, on a track of a CPU thread or the GPU. ScopedTimer
+// records the CPU time of a scope, and glTimerQuery records the GPU time of
+// the draw passes into the same timeline.
+//
+// The events are kept in a ring buffer of fixed capacity (power of 2), the
+// oldest events are overwritten. record() is lock-free and does not allocate,
+// so it can be called from any thread in the frame loop. Each slot has a
+// sequence number written before and after the event (seqlock), so the
+// reader skips the slots being overwritten instead of blocking the writers.
+//
+// The event names are not copied, they must be string literals.
+// The profiler is disabled by default, then ScopedTimer costs a load of flag.
+//
+// Open the JSON file with chrome://tracing or https://ui.perfetto.dev
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef FRAME_PROFILER_H_DEF
+#define FRAME_PROFILER_H_DEF
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+// a timed span on a track
+struct ProfileEvent
+{
+    const char* name;               // string literal
+    unsigned long long start;       // ns since the profiler is created
+    unsigned long long duration;    // ns
+    unsigned int frame;             // frame number at record()
+    unsigned int track;             // TRACK_GPU or CPU thread index (1, 2, ...)
+};
+
+class FrameProfiler
+{
+public:
+    enum { TRACK_GPU = 0, DEFAULT_CAPACITY = 1 << 16 };
+
+    // ctor/dtor
+    explicit FrameProfiler(unsigned int capacity=DEFAULT_CAPACITY);  // rounded up to power of 2
+    ~FrameProfiler();
+
+    static FrameProfiler& getInstance();            // shared profiler
+
+    void setEnabled(bool flag)                      { enabled.store(flag, std::memory_order_relaxed); }
+    bool isEnabled() const                          { return enabled.load(std::memory_order_relaxed); }
+
+    // increase the frame number of the next events
+    void beginFrame()                               { frame.fetch_add(1, std::memory_order_relaxed); }
+    unsigned int getFrame() const                   { return frame.load(std::memory_order_relaxed); }
+
+    // ns since the profiler is created
+    unsigned long long now() const;
+
+    // add an event, lock-free and wait-free
+    void record(const char* name, unsigned long long start, unsigned long long end,
+                unsigned int track, unsigned int frame);
+    void record(const char* name, unsigned long long start, unsigned long long end, unsigned int track);
+    void record(const char* name, unsigned long long start, unsigned long long end);   // track of this thread
+
+    // copy the events in the buffer, oldest first, and return the count
+    unsigned int getEvents(std::vector<ProfileEvent>& events) const;
+
+    // drop all events, must not be called while recording
+    void clear();
+
+    // Chrome trace event format: {"traceEvents":[{"ph":"X", ...}, ...]}
+    std::string toChromeTrace() const;
+    bool writeChromeTrace(const char* fileName) const;
+
+    // track of the calling thread, assigned at the first call
+    static unsigned int getThreadTrack();
+
+    unsigned int getCapacity() const                { return capacity; }
+    unsigned long long getRecordCount() const       { return writeIndex.load(std::memory_order_relaxed); }
+
+private:
+    FrameProfiler(const FrameProfiler& rhs);        // no implementation
+    FrameProfiler& operator=(const FrameProfiler& rhs);
+
+    // event with its sequence number
+    // sequence: 2*i+1 while the i-th event is written, 2*i+2 when it is done
+    struct Slot
+    {
+        std::atomic<unsigned long long> sequence;
+        std::atomic<const char*> name;
+        std::atomic<unsigned long long> start;
+        std::atomic<unsigned long long> duration;
+        std::atomic<unsigned int> frame;
+        std::atomic<unsigned int> track;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    unsigned int capacity;
+    unsigned int mask;
+    std::atomic<unsigned long long> writeIndex;     // # of events recorded
+    std::atomic<unsigned int> frame;
+    std::atomic<bool> enabled;
+    std::chrono::steady_clock::time_point origin;
+};
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// record the CPU time of a scope into FrameProfiler::getInstance()
+// usage: { ScopedTimer timer("grid"); drawGrid(); }
+///////////////////////////////////////////////////////////////////////////////
+class ScopedTimer
+{
+public:
+    explicit ScopedTimer(const char* name) : name(name), start(0), enabled(false)
+    {
+        FrameProfiler& profiler = FrameProfiler::getInstance();
+        if(profiler.isEnabled())
+        {
+            enabled = true;
+            start = profiler.now();
+        }
+    }
+    ~ScopedTimer()
+    {
+        if(enabled)
+        {
+            FrameProfiler& profiler = FrameProfiler::getInstance();
+            profiler.record(name, start, profiler.now());
+        }
+    }
+
+private:
+    ScopedTimer(const ScopedTimer& rhs);            // no implementation
+    ScopedTimer& operator=(const ScopedTimer& rhs);
+
+    const char* name;
+    unsigned long long start;
+    bool enabled;
+};
+
+#endif
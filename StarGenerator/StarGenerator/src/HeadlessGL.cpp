@@ -0,0 +1,305 @@
+///////////////////////////////////////////////////////////////////////////////
+// HeadlessGL.cpp
+// ==============
+// offscreen OpenGL rendering context without window and display, for Linux
+// It needs EGL_MESA_platform_surfaceless (or a default EGL display),
+// EGL_KHR_surfaceless_context and GL_ARB_framebuffer_object.
+//
+// Link with -lEGL -lGL (libglvnd). Not for Windows, use Win::ViewGL instead.
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include "HeadlessGL.h"
+#include <EGL/eglext.h>
+#include <algorithm>
+#include <cstdio>
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor / dtor
+///////////////////////////////////////////////////////////////////////////////
+HeadlessGL::HeadlessGL() : display(EGL_NO_DISPLAY), context(EGL_NO_CONTEXT), fbo(0), rboColor(0),
+                           rboDepth(0), fboResolve(0), rboResolve(0), width(0), height(0)
+{
+}
+
+HeadlessGL::~HeadlessGL()
+{
+    closeContext();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// create OpenGL context (compatibility profile for fixed functions of
+// ModelGL), make it current without any surface, then create FBO to render
+///////////////////////////////////////////////////////////////////////////////
+bool HeadlessGL::createContext(int width, int height, int msaaSamples)
+{
+    closeContext();
+
+    if(width <= 0 || height <= 0)
+    {
+        errorMessage = "invalid framebuffer size";
+        return false;
+    }
+
+    if(!initDisplay())
+        return false;
+
+    if(!eglBindAPI(EGL_OPENGL_API))
+    {
+        errorMessage = "desktop OpenGL is not supported by EGL";
+        closeContext();
+        return false;
+    }
+
+    // no surface is used, but surfaceless configs are pbuffer type, not the
+    // default window type
+    const EGLint configAttribs[] = {EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+                                    EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE};
+    EGLConfig config;
+    EGLint configCount = 0;
+    if(!eglChooseConfig(display, configAttribs, &config, 1, &configCount) || configCount == 0)
+    {
+        errorMessage = "no EGL config for OpenGL";
+        closeContext();
+        return false;
+    }
+
+    context = eglCreateContext(display, config, EGL_NO_CONTEXT, 0);
+    if(context == EGL_NO_CONTEXT)
+    {
+        errorMessage = "failed to create EGL context";
+        closeContext();
+        return false;
+    }
+
+    if(!eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context))
+    {
+        errorMessage = "failed to make EGL context current (EGL_KHR_surfaceless_context)";
+        closeContext();
+        return false;
+    }
+
+    this->width = width;
+    this->height = height;
+    if(!createFramebuffer(msaaSamples))
+    {
+        closeContext();
+        return false;
+    }
+
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// delete FBO and context, then terminate the display
+///////////////////////////////////////////////////////////////////////////////
+void HeadlessGL::closeContext()
+{
+    if(context != EGL_NO_CONTEXT)
+    {
+        deleteFramebuffer();
+        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        eglDestroyContext(display, context);
+        context = EGL_NO_CONTEXT;
+    }
+
+    if(display != EGL_NO_DISPLAY)
+    {
+        eglTerminate(display);
+        display = EGL_NO_DISPLAY;
+    }
+
+    width = height = 0;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// get the surfaceless display of Mesa if available, otherwise default one
+///////////////////////////////////////////////////////////////////////////////
+bool HeadlessGL::initDisplay()
+{
+    PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+        (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+    if(getPlatformDisplay)
+        display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, 0);
+    if(display == EGL_NO_DISPLAY)
+        display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+    EGLint major, minor;
+    if(display == EGL_NO_DISPLAY || !eglInitialize(display, &major, &minor))
+    {
+        errorMessage = "failed to initialize EGL display";
+        display = EGL_NO_DISPLAY;
+        return false;
+    }
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// create FBO with color and depth/stencil renderbuffers, and bind it
+// With MSAA, the frame is resolved into another FBO before reading.
+///////////////////////////////////////////////////////////////////////////////
+bool HeadlessGL::createFramebuffer(int msaaSamples)
+{
+    glGenRenderbuffers(1, &rboColor);
+    glBindRenderbuffer(GL_RENDERBUFFER, rboColor);
+    glRenderbufferStorageMultisample(GL_RENDERBUFFER, msaaSamples, GL_RGBA8, width, height);
+
+    glGenRenderbuffers(1, &rboDepth);
+    glBindRenderbuffer(GL_RENDERBUFFER, rboDepth);
+    glRenderbufferStorageMultisample(GL_RENDERBUFFER, msaaSamples, GL_DEPTH24_STENCIL8, width, height);
+
+    glGenFramebuffers(1, &fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, rboColor);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, rboDepth);
+    if(glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    {
+        errorMessage = "incomplete framebuffer";
+        return false;
+    }
+
+    if(msaaSamples > 0)
+    {
+        glGenRenderbuffers(1, &rboResolve);
+        glBindRenderbuffer(GL_RENDERBUFFER, rboResolve);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+
+        glGenFramebuffers(1, &fboResolve);
+        glBindFramebuffer(GL_FRAMEBUFFER, fboResolve);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, rboResolve);
+        if(glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        {
+            errorMessage = "incomplete resolve framebuffer";
+            return false;
+        }
+    }
+
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glViewport(0, 0, width, height);
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// delete FBOs and renderbuffers
+///////////////////////////////////////////////////////////////////////////////
+void HeadlessGL::deleteFramebuffer()
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    if(fbo)
+        glDeleteFramebuffers(1, &fbo);
+    if(fboResolve)
+        glDeleteFramebuffers(1, &fboResolve);
+    if(rboColor)
+        glDeleteRenderbuffers(1, &rboColor);
+    if(rboDepth)
+        glDeleteRenderbuffers(1, &rboDepth);
+    if(rboResolve)
+        glDeleteRenderbuffers(1, &rboResolve);
+
+    fbo = fboResolve = 0;
+    rboColor = rboDepth = rboResolve = 0;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// block until all commands are done, to measure frame time
+///////////////////////////////////////////////////////////////////////////////
+void HeadlessGL::finish()
+{
+    glFinish();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// read RGBA pixels of the frame, flipped vertically to be top row first
+///////////////////////////////////////////////////////////////////////////////
+bool HeadlessGL::readPixels(std::vector<unsigned char>& pixels)
+{
+    if(!fbo)
+        return false;
+
+    // resolve MSAA samples
+    if(fboResolve)
+    {
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fboResolve);
+        glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, fboResolve);
+    }
+
+    const size_t rowSize = (size_t)width * 4;
+    std::vector<unsigned char> frame(rowSize * height);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, &frame[0]);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+
+    pixels.resize(frame.size());
+    for(int i = 0; i < height; ++i)
+        std::copy(&frame[rowSize * (height - 1 - i)], &frame[rowSize * (height - i)], &pixels[rowSize * i]);
+
+    return glGetError() == GL_NO_ERROR;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// save the frame as binary PPM (RGB, alpha is dropped)
+///////////////////////////////////////////////////////////////////////////////
+bool HeadlessGL::saveImage(const char* fileName)
+{
+    std::vector<unsigned char> pixels;
+    if(!readPixels(pixels))
+    {
+        errorMessage = "failed to read pixels";
+        return false;
+    }
+
+    FILE* file = std::fopen(fileName, "wb");
+    if(!file)
+    {
+        errorMessage = std::string("cannot open ") + fileName;
+        return false;
+    }
+
+    std::fprintf(file, "P6\n%d %d\n255\n", width, height);
+    const size_t pixelCount = (size_t)width * height;
+    std::vector<unsigned char> rgb(pixelCount * 3);
+    for(size_t i = 0; i < pixelCount; ++i)
+    {
+        rgb[i * 3]     = pixels[i * 4];
+        rgb[i * 3 + 1] = pixels[i * 4 + 1];
+        rgb[i * 3 + 2] = pixels[i * 4 + 2];
+    }
+    bool ok = std::fwrite(&rgb[0], 1, rgb.size(), file) == rgb.size();
+    std::fclose(file);
+    return ok;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return the name of renderer, e.g. "llvmpipe (LLVM 15.0.7, 256 bits)"
+///////////////////////////////////////////////////////////////////////////////
+std::string HeadlessGL::getRenderer() const
+{
+    const char* str = (const char*)glGetString(GL_RENDERER);
+    return str ? str : "";
+}
@@ -0,0 +1,77 @@
+///////////////////////////////////////////////////////////////////////////////
+// HeadlessGL.h
+// ============
+// offscreen OpenGL rendering context without window and display, for Linux
+// It creates an EGL context on the surfaceless platform (Mesa), so it runs on
+// CPU-only llvmpipe drivers, and renders into a framebuffer object. The frame
+// can be read back to memory or saved into a PPM image file.
+//
+// It is the counterpart of Win::ViewGL for build hosts and CI machines with
+// no GPU or display. Run it with the software driver, if there is no GPU;
+//   LIBGL_ALWAYS_SOFTWARE=1 ./program
+//
+// usage:
+//   HeadlessGL headless;
+//   headless.createContext(width, height);
+//   model.init();
+//   model.setWindowSize(width, height);
+//   model.draw();
+//   headless.saveImage("frame.ppm");
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef HEADLESS_GL_H
+#define HEADLESS_GL_H
+
+#ifndef EGL_NO_X11
+#define EGL_NO_X11                                  // no Xlib types in EGL headers
+#endif
+
+#include <EGL/egl.h>
+#include <string>
+#include <vector>
+#include "glExtension.h"
+
+class HeadlessGL
+{
+public:
+    HeadlessGL();
+    ~HeadlessGL();
+
+    // create EGL context and FBO of the size, and make it current
+    bool createContext(int width, int height, int msaaSamples=0);
+    void closeContext();
+
+    void finish();                                  // wait until the frame is done
+
+    // read the frame, RGBA 8 bits per channel, from top row to bottom
+    bool readPixels(std::vector<unsigned char>& pixels);
+    bool saveImage(const char* fileName);           // binary PPM (P6)
+
+    int getWidth() const                            { return width; }
+    int getHeight() const                           { return height; }
+    std::string getRenderer() const;                // GL_RENDERER string
+    const std::string& getErrorMessage() const      { return errorMessage; }
+
+protected:
+
+private:
+    bool initDisplay();
+    bool createFramebuffer(int msaaSamples);
+    void deleteFramebuffer();
+
+    EGLDisplay display;
+    EGLContext context;
+    GLuint fbo;                                     // render target
+    GLuint rboColor;
+    GLuint rboDepth;
+    GLuint fboResolve;                              // to resolve MSAA before reading
+    GLuint rboResolve;
+    int width;
+    int height;
+    std::string errorMessage;
+};
+
+#endif
@@ -9,11 +9,11 @@
 //            | 2 5 8 |    |  2  6 10 14 |
 //                         |  3  7 11 15 |
 //
-// Dependencies: Vector2, Vector3, Vector3
+// Dependencies: Vector2, Vector3, Vector3, cpuFeature
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2005-06-24
-// UPDATED: 2016-07-06
+// UPDATED: 2026-10-18
 //
 // Copyright (C) 2005 Song Ho Ahn
 ///////////////////////////////////////////////////////////////////////////////
@@ -21,6 +21,11 @@
 #include <cmath>
 #include <algorithm>
 #include "Matrices.h"
+#include "cpuFeature.h"
+
+#ifdef CPU_X86
+#include <xmmintrin.h>
+#endif
 
 const float DEG2RAD = 3.141593f / 180.0f;
 const float RAD2DEG = 180.0f / 3.141593f;
@@ -219,6 +224,8 @@ Matrix4& Matrix4::transpose()
     std::swap(m[7],  m[13]);
     std::swap(m[11], m[14]);
 
+    if(kind != KIND_IDENTITY)
+        kind = KIND_UNKNOWN;
     return *this;
 }
 
@@ -226,22 +233,37 @@ Matrix4& Matrix4::transpose()
 
 ///////////////////////////////////////////////////////////////////////////////
 // inverse 4x4 matrix
+// It uses the cheapest method for the kind of matrix. The kind is tracked by
+// the transform functions, or classified here once.
 ///////////////////////////////////////////////////////////////////////////////
 Matrix4& Matrix4::invert()
 {
-    // If the 4th row is [0,0,0,1] then it is affine matrix and
-    // it has no projective transformation.
-    if(m[3] == 0 && m[7] == 0 && m[11] == 0 && m[15] == 1)
-        this->invertAffine();
-    else
+    // the inverse is the same kind
+    kind = getKind();
+    switch(kind)
     {
-        this->invertGeneral();
+    case KIND_IDENTITY:
+        break;
+    case KIND_TRANSLATION:
+        m[12] = -m[12];
+        m[13] = -m[13];
+        m[14] = -m[14];
+        break;
+    case KIND_EUCLIDEAN:
+        invertEuclidean();
+        break;
+    case KIND_AFFINE:
+        invertAffine();
+        break;
+    default:
+        invertGeneral();
         /*@@ invertProjective() is not optimized (slower than generic one)
         if(fabs(m[0]*m[5] - m[1]*m[4]) > EPSILON)
             this->invertProjective();   // inverse using matrix partition
         else
             this->invertGeneral();      // generalized inverse
         */
+        break;
     }
 
     return *this;
@@ -249,6 +271,50 @@ Matrix4& Matrix4::invert()
 
 
 
+///////////////////////////////////////////////////////////////////////////////
+// return the kind of matrix, classify it if it is unknown
+// It does not store the classified kind, so it is safe to call on a const
+// matrix shared by threads. invert() stores it.
+// The 3x3 part is Euclidean if its columns are orthonormal within EPSILON,
+// the same tolerance as rotate() accepts the axis as unit length.
+///////////////////////////////////////////////////////////////////////////////
+Matrix4::Kind Matrix4::getKind() const
+{
+    return (kind != KIND_UNKNOWN) ? kind : classify();
+}
+
+Matrix4::Kind Matrix4::classify() const
+{
+    // If the 4th row is [0,0,0,1] then it is affine matrix and
+    // it has no projective transformation.
+    if(m[3] != 0 || m[7] != 0 || m[11] != 0 || m[15] != 1)
+        return KIND_PROJECTIVE;
+
+    if(m[0] != 1 || m[1] != 0 || m[2] != 0 ||
+       m[4] != 0 || m[5] != 1 || m[6] != 0 ||
+       m[8] != 0 || m[9] != 0 || m[10]!= 1)
+    {
+        // R^T * R = I
+        float d00 = m[0]*m[0] + m[1]*m[1] + m[2]*m[2];
+        float d11 = m[4]*m[4] + m[5]*m[5] + m[6]*m[6];
+        float d22 = m[8]*m[8] + m[9]*m[9] + m[10]*m[10];
+        float d01 = m[0]*m[4] + m[1]*m[5] + m[2]*m[6];
+        float d02 = m[0]*m[8] + m[1]*m[9] + m[2]*m[10];
+        float d12 = m[4]*m[8] + m[5]*m[9] + m[6]*m[10];
+        if(fabs(d00 - 1) <= EPSILON && fabs(d11 - 1) <= EPSILON && fabs(d22 - 1) <= EPSILON &&
+           fabs(d01) <= EPSILON && fabs(d02) <= EPSILON && fabs(d12) <= EPSILON)
+            return KIND_EUCLIDEAN;
+        return KIND_AFFINE;
+    }
+
+    if(m[12] != 0 || m[13] != 0 || m[14] != 0)
+        return KIND_TRANSLATION;
+
+    return KIND_IDENTITY;
+}
+
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // compute the inverse of 4x4 Euclidean transformation matrix
 //
@@ -299,6 +365,48 @@ Matrix4& Matrix4::invertEuclidean()
 
 
 
+#ifdef CPU_X86
+///////////////////////////////////////////////////////////////////////////////
+// SSE helpers for invertAffine() and invertGeneral()
+// SWIZZLE(v, x,y,z,w) = (v[x], v[y], v[z], v[w])
+// SHUFFLE(a, b, x,y,z,w) = (a[x], a[y], b[z], b[w])
+///////////////////////////////////////////////////////////////////////////////
+#define SHUFFLE(a, b, x, y, z, w)   _mm_shuffle_ps(a, b, _MM_SHUFFLE(w, z, y, x))
+#define SWIZZLE(v, x, y, z, w)      SHUFFLE(v, v, x, y, z, w)
+
+// cross product of xyz, w = 0
+static inline __m128 cross3(__m128 a, __m128 b)
+{
+    __m128 c = _mm_sub_ps(_mm_mul_ps(a, SWIZZLE(b, 1, 2, 0, 3)), _mm_mul_ps(SWIZZLE(a, 1, 2, 0, 3), b));
+    return SWIZZLE(c, 1, 2, 0, 3);
+}
+
+// sum of 4 elements in all elements
+static inline __m128 sum4(__m128 v)
+{
+    v = _mm_add_ps(v, SWIZZLE(v, 1, 0, 3, 2));
+    return _mm_add_ps(v, SWIZZLE(v, 2, 3, 0, 1));
+}
+
+// 2x2 matrices stored as (m00, m01, m10, m11); A*B, adj(A)*B, A*adj(B)
+static inline __m128 mat2Mul(__m128 a, __m128 b)
+{
+    return _mm_add_ps(_mm_mul_ps(a, SWIZZLE(b, 0, 3, 0, 3)), _mm_mul_ps(SWIZZLE(a, 1, 0, 3, 2), SWIZZLE(b, 2, 1, 2, 1)));
+}
+
+static inline __m128 mat2AdjMul(__m128 a, __m128 b)
+{
+    return _mm_sub_ps(_mm_mul_ps(SWIZZLE(a, 3, 3, 0, 0), b), _mm_mul_ps(SWIZZLE(a, 1, 1, 2, 2), SWIZZLE(b, 2, 3, 0, 1)));
+}
+
+static inline __m128 mat2MulAdj(__m128 a, __m128 b)
+{
+    return _mm_sub_ps(_mm_mul_ps(a, SWIZZLE(b, 3, 0, 3, 0)), _mm_mul_ps(SWIZZLE(a, 1, 0, 3, 2), SWIZZLE(b, 2, 1, 2, 1)));
+}
+#endif
+
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // compute the inverse of a 4x4 affine transformation matrix
 //
@@ -314,9 +422,49 @@ Matrix4& Matrix4::invertEuclidean()
 //  [ R | T ]-1   [ R^-1 | -R^-1 * T ]
 //  [ --+-- ]   = [ -----+---------- ]
 //  [ 0 | 1 ]     [  0   +     1     ]
+//
+// The SSE version computes R^-1 with the cross products of the columns of R.
 ///////////////////////////////////////////////////////////////////////////////
 Matrix4& Matrix4::invertAffine()
 {
+#ifdef CPU_X86
+    // the rows of R^-1 are the cross products of the columns of R
+    __m128 c0 = _mm_loadu_ps(m);
+    __m128 c1 = _mm_loadu_ps(m + 4);
+    __m128 c2 = _mm_loadu_ps(m + 8);
+    __m128 t = _mm_loadu_ps(m + 12);
+    __m128 r0 = cross3(c1, c2);
+    __m128 r1 = cross3(c2, c0);
+    __m128 r2 = cross3(c0, c1);
+    __m128 r3 = _mm_setzero_ps();
+
+    float determinant = _mm_cvtss_f32(sum4(_mm_mul_ps(c0, r0)));
+    if(fabs(determinant) <= EPSILON)
+    {
+        // cannot inverse R, make it identity same as Matrix3::invert()
+        r0 = _mm_setr_ps(1, 0, 0, 0);
+        r1 = _mm_setr_ps(0, 1, 0, 0);
+        r2 = _mm_setr_ps(0, 0, 1, 0);
+    }
+    else
+    {
+        __m128 invDeterminant = _mm_set1_ps(1.0f / determinant);
+        r0 = _mm_mul_ps(r0, invDeterminant);
+        r1 = _mm_mul_ps(r1, invDeterminant);
+        r2 = _mm_mul_ps(r2, invDeterminant);
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);      // rows to columns
+    }
+
+    // -R^-1 * T
+    t = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r0, SWIZZLE(t, 0, 0, 0, 0)),
+                              _mm_mul_ps(r1, SWIZZLE(t, 1, 1, 1, 1))),
+                   _mm_mul_ps(r2, SWIZZLE(t, 2, 2, 2, 2)));
+    _mm_storeu_ps(m, r0);
+    _mm_storeu_ps(m + 4, r1);
+    _mm_storeu_ps(m + 8, r2);
+    _mm_storeu_ps(m + 12, _mm_sub_ps(_mm_setzero_ps(), t));
+    m[15] = 1.0f;
+#else
     // R^-1
     Matrix3 r(m[0],m[1],m[2], m[4],m[5],m[6], m[8],m[9],m[10]);
     r.invert();
@@ -336,6 +484,8 @@ Matrix4& Matrix4::invertAffine()
     //m[3] = m[7] = m[11] = 0.0f;
     //m[15] = 1.0f;
 
+#endif
+
     return * this;
 }
 
@@ -413,9 +563,61 @@ Matrix4& Matrix4::invertProjective()
 // compute the inverse of a general 4x4 matrix using Cramer's Rule
 // If cannot find inverse, return indentity matrix
 // M^-1 = adj(M) / det(M)
+// The SSE version computes adj(M) with 2x2 sub-matrices instead of cofactors.
 ///////////////////////////////////////////////////////////////////////////////
 Matrix4& Matrix4::invertGeneral()
 {
+#ifdef CPU_X86
+    // blockwise inverse with 2x2 sub-matrices; the columns are used as rows,
+    // and the inverse of transpose is the transpose of inverse.
+    // M = | A B |  M^-1 = 1/|M| * | adj(X) adj(Y) |
+    //     | C D |                 | adj(Z) adj(W) |
+    __m128 v0 = _mm_loadu_ps(m);
+    __m128 v1 = _mm_loadu_ps(m + 4);
+    __m128 v2 = _mm_loadu_ps(m + 8);
+    __m128 v3 = _mm_loadu_ps(m + 12);
+    __m128 a = _mm_movelh_ps(v0, v1);
+    __m128 b = _mm_movehl_ps(v1, v0);
+    __m128 c = _mm_movelh_ps(v2, v3);
+    __m128 d = _mm_movehl_ps(v3, v2);
+
+    // determinants of sub-matrices (|A|, |B|, |C|, |D|)
+    __m128 detSub = _mm_sub_ps(_mm_mul_ps(SHUFFLE(v0, v2, 0, 2, 0, 2), SHUFFLE(v1, v3, 1, 3, 1, 3)),
+                               _mm_mul_ps(SHUFFLE(v0, v2, 1, 3, 1, 3), SHUFFLE(v1, v3, 0, 2, 0, 2)));
+    __m128 detA = SWIZZLE(detSub, 0, 0, 0, 0);
+    __m128 detB = SWIZZLE(detSub, 1, 1, 1, 1);
+    __m128 detC = SWIZZLE(detSub, 2, 2, 2, 2);
+    __m128 detD = SWIZZLE(detSub, 3, 3, 3, 3);
+
+    __m128 dc = mat2AdjMul(d, c);                                       // adj(D)*C
+    __m128 ab = mat2AdjMul(a, b);                                       // adj(A)*B
+    __m128 x = _mm_sub_ps(_mm_mul_ps(detD, a), mat2Mul(b, dc));         // |D|A - B(adj(D)C)
+    __m128 w = _mm_sub_ps(_mm_mul_ps(detA, d), mat2Mul(c, ab));         // |A|D - C(adj(A)B)
+    __m128 y = _mm_sub_ps(_mm_mul_ps(detB, c), mat2MulAdj(d, ab));      // |B|C - D adj(adj(A)B)
+    __m128 z = _mm_sub_ps(_mm_mul_ps(detC, b), mat2MulAdj(a, dc));      // |C|B - A adj(adj(D)C)
+
+    // |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+    __m128 determinant = _mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC));
+    determinant = _mm_sub_ps(determinant, sum4(_mm_mul_ps(ab, SWIZZLE(dc, 0, 2, 1, 3))));
+    if(fabs(_mm_cvtss_f32(determinant)) <= EPSILON)
+    {
+        return identity();
+    }
+
+    // signs of adjugate
+    __m128 invDeterminant = _mm_div_ps(_mm_setr_ps(1, -1, -1, 1), determinant);
+    x = _mm_mul_ps(x, invDeterminant);
+    y = _mm_mul_ps(y, invDeterminant);
+    z = _mm_mul_ps(z, invDeterminant);
+    w = _mm_mul_ps(w, invDeterminant);
+
+    // adjugate and store
+    _mm_storeu_ps(m,      SHUFFLE(x, y, 3, 1, 3, 1));
+    _mm_storeu_ps(m + 4,  SHUFFLE(x, y, 2, 0, 2, 0));
+    _mm_storeu_ps(m + 8,  SHUFFLE(z, w, 3, 1, 3, 1));
+    _mm_storeu_ps(m + 12, SHUFFLE(z, w, 2, 0, 2, 0));
+    return *this;
+#else
     // get cofactors of minor matrices
     float cofactor0 = getCofactor(m[5],m[6],m[7], m[9],m[10],m[11], m[13],m[14],m[15]);
     float cofactor1 = getCofactor(m[4],m[6],m[7], m[8],m[10],m[11], m[12],m[14],m[15]);
@@ -469,6 +671,7 @@ Matrix4& Matrix4::invertGeneral()
     m[15]=  invDeterminant * cofactor15;
 
     return *this;
+#endif
 }
 
 
@@ -516,6 +719,7 @@ Matrix4& Matrix4::translate(float x, float y, float z)
     m[1] += m[3] * y;   m[5] += m[7] * y;   m[9] += m[11]* y;   m[13]+= m[15]* y;
     m[2] += m[3] * z;   m[6] += m[7] * z;   m[10]+= m[11]* z;   m[14]+= m[15]* z;
 
+    raiseKind(KIND_TRANSLATION);
     return *this;
 }
 
@@ -534,6 +738,8 @@ Matrix4& Matrix4::scale(float x, float y, float z)
     m[0] *= x;   m[4] *= x;   m[8] *= x;   m[12] *= x;
     m[1] *= y;   m[5] *= y;   m[9] *= y;   m[13] *= y;
     m[2] *= z;   m[6] *= z;   m[10]*= z;   m[14] *= z;
+
+    raiseKind(KIND_AFFINE);
     return *this;
 }
 
@@ -582,6 +788,8 @@ Matrix4& Matrix4::rotate(float angle, float x, float y, float z)
     m[13]= r1 * m12+ r5 * m13+ r9 * m14;
     m[14]= r2 * m12+ r6 * m13+ r10* m14;
 
+    // not orthogonal if the axis is not unit length
+    raiseKind(fabs(x*x + y*y + z*z - 1) <= EPSILON ? KIND_EUCLIDEAN : KIND_AFFINE);
     return *this;
 }
 
@@ -603,6 +811,7 @@ Matrix4& Matrix4::rotateX(float angle)
     m[13]= m13* c + m14*-s;
     m[14]= m13* s + m14* c;
 
+    raiseKind(KIND_EUCLIDEAN);
     return *this;
 }
 
@@ -624,6 +833,7 @@ Matrix4& Matrix4::rotateY(float angle)
     m[12]= m12* c + m14* s;
     m[14]= m12*-s + m14* c;
 
+    raiseKind(KIND_EUCLIDEAN);
     return *this;
 }
 
@@ -645,6 +855,7 @@ Matrix4& Matrix4::rotateZ(float angle)
     m[12]= m12* c + m13*-s;
     m[13]= m12* s + m13* c;
 
+    raiseKind(KIND_EUCLIDEAN);
     return *this;
 }
 
@@ -692,10 +903,14 @@ Matrix4& Matrix4::lookAt(const Vector3& target)
     //up.normalize();
 
     // NOTE: overwrite rotation and scale info of the current matrix
+    Kind k = getKind();
     this->setColumn(0, left);
     this->setColumn(1, up);
     this->setColumn(2, forward);
 
+    // rotation is orthonormal, the last row is unchanged
+    if(k != KIND_PROJECTIVE)
+        kind = KIND_EUCLIDEAN;
     return *this;
 }
 
@@ -715,10 +930,14 @@ Matrix4& Matrix4::lookAt(const Vector3& target, const Vector3& upVec)
     up.normalize();
 
     // NOTE: overwrite rotation and scale info of the current matrix
+    Kind k = getKind();
     this->setColumn(0, left);
     this->setColumn(1, up);
     this->setColumn(2, forward);
 
+    // rotation is orthonormal, the last row is unchanged
+    if(k != KIND_PROJECTIVE)
+        kind = KIND_EUCLIDEAN;
     return *this;
 }
 
@@ -9,11 +9,26 @@
 //            | 2 5 8 |    |  2  6 10 14 |
 //                         |  3  7 11 15 |
 //
-// Dependencies: Vector2, Vector3, Vector3
+// Matrix4 multiplications (M*M, M*v) use SSE on x86, and AVX for M*M if the
+// compiler targets AVX (/arch:AVX, -mavx). The scalar version is used on the
+// other CPUs. The elements of Matrix4 are 16-byte aligned.
+//
+// Matrix4 keeps the kind of transform (identity, translation, Euclidean,
+// affine or projective) while it is built by identity(), translate(),
+// rotate(), scale(), lookAt() and multiplications, so invert() jumps to the
+// cheapest inverse without inspecting the matrix. Writing the elements
+// directly (set(), setRow(), operator[], ...) makes the kind unknown, then
+// invert() classifies it once by the last row and 3x3 part.
+// The non-const operator[] makes the kind unknown when the reference is
+// returned, so the reference must not be kept over the next call of the
+// matrix (a write after it would leave a stale kind). Use the const
+// operator[] or get() to read without losing the kind.
+//
+// Dependencies: Vector2, Vector3, Vector3, cpuFeature
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2005-06-24
-// UPDATED: 2016-07-06
+// UPDATED: 2026-10-18
 //
 // Copyright (C) 2005 Song Ho Ahn
 ///////////////////////////////////////////////////////////////////////////////
@@ -24,6 +39,11 @@
 #include <iostream>
 #include <iomanip>
 #include "Vectors.h"
+#include "cpuFeature.h"
+
+#ifdef CPU_X86
+#include <immintrin.h>
+#endif
 
 ///////////////////////////////////////////////////////////////////////////
 // 2x2 matrix
@@ -145,6 +165,17 @@ private:
 class Matrix4
 {
 public:
+    // kind of transform, each kind includes the previous kinds
+    enum Kind
+    {
+        KIND_UNKNOWN = 0,                               // not classified yet
+        KIND_IDENTITY,
+        KIND_TRANSLATION,                               // translation only
+        KIND_EUCLIDEAN,                                 // rotation, reflection, translation
+        KIND_AFFINE,                                    // + scale, shear
+        KIND_PROJECTIVE                                 // last row is not (0,0,0,1)
+    };
+
     // constructors
     Matrix4();  // init with identity
     Matrix4(const float src[16]);
@@ -170,10 +201,11 @@ public:
     float       getDeterminant();
     Matrix3     getRotationMatrix();                    // return 3x3 rotation part
     Vector3     getAngle();                             // return (pitch, yaw, roll)
+    Kind        getKind() const;                        // classify if unknown, not cached
 
     Matrix4&    identity();
     Matrix4&    transpose();                            // transpose itself and return reference
-    Matrix4&    invert();                               // check best inverse method before inverse
+    Matrix4&    invert();                               // inverse by the kind of matrix
     Matrix4&    invertEuclidean();                      // inverse of Euclidean transform matrix
     Matrix4&    invertAffine();                         // inverse of affine transform matrix
     Matrix4&    invertProjective();                     // inverse of projective matrix using partitioning
@@ -207,7 +239,7 @@ public:
     bool        operator==(const Matrix4& rhs) const;   // exact compare, no epsilon
     bool        operator!=(const Matrix4& rhs) const;   // exact compare, no epsilon
     float       operator[](int index) const;            // subscript operator v[0], v[1]
-    float&      operator[](int index);                  // subscript operator v[0], v[1]
+    float&      operator[](int index);                  // makes the kind unknown, do not keep the reference
 
     // friends functions
     friend Matrix4 operator-(const Matrix4& m);                     // unary operator (-)
@@ -222,9 +254,13 @@ private:
     float       getCofactor(float m0, float m1, float m2,
                             float m3, float m4, float m5,
                             float m6, float m7, float m8);
+    Kind        classify() const;
+    void        raiseKind(Kind k)                       { if(kind != KIND_UNKNOWN && kind < k) kind = k; }
+    static Kind combineKind(Kind a, Kind b)             { return (a == KIND_UNKNOWN || b == KIND_UNKNOWN) ? KIND_UNKNOWN : (a > b ? a : b); }
 
-    float m[16];
-    float tm[16];                                       // transpose m
+    alignas(16) float m[16];
+    alignas(16) float tm[16];                           // transpose m
+    Kind        kind;                                   // tracked by transforms, cached by invert()
 
 };
 
@@ -650,6 +686,105 @@ inline std::ostream& operator<<(std::ostream& os, const Matrix3& m)
 
 
 
+///////////////////////////////////////////////////////////////////////////
+// kernels for Matrix4 multiplications, column major
+// out = a * b, out = a * (x,y,z,w). out must not overlap with the inputs.
+// The SIMD versions add the products in the same order as the scalar one,
+// but they may be fused to FMA if the compiler targets FMA (-mfma, -march),
+// then the results may differ by 1 ulp.
+// Unaligned loads are used; they are as fast as aligned loads on aligned
+// data, and still safe for a Matrix4 in heap memory without aligned new.
+///////////////////////////////////////////////////////////////////////////
+inline void multiplyMatrix4Scalar(const float a[16], const float b[16], float out[16])
+{
+    for(int j = 0; j < 16; j += 4)
+    {
+        out[j]   = a[0]*b[j] + a[4]*b[j+1] + a[8]*b[j+2]  + a[12]*b[j+3];
+        out[j+1] = a[1]*b[j] + a[5]*b[j+1] + a[9]*b[j+2]  + a[13]*b[j+3];
+        out[j+2] = a[2]*b[j] + a[6]*b[j+1] + a[10]*b[j+2] + a[14]*b[j+3];
+        out[j+3] = a[3]*b[j] + a[7]*b[j+1] + a[11]*b[j+2] + a[15]*b[j+3];
+    }
+}
+
+inline void transformVector4Scalar(const float a[16], float x, float y, float z, float w, float out[4])
+{
+    out[0] = a[0]*x + a[4]*y + a[8]*z  + a[12]*w;
+    out[1] = a[1]*x + a[5]*y + a[9]*z  + a[13]*w;
+    out[2] = a[2]*x + a[6]*y + a[10]*z + a[14]*w;
+    out[3] = a[3]*x + a[7]*y + a[11]*z + a[15]*w;
+}
+
+#ifdef CPU_X86
+// each column of out is a linear combination of the columns of a
+inline void multiplyMatrix4Sse(const float a[16], const float b[16], float out[16])
+{
+    __m128 a0 = _mm_loadu_ps(a);
+    __m128 a1 = _mm_loadu_ps(a + 4);
+    __m128 a2 = _mm_loadu_ps(a + 8);
+    __m128 a3 = _mm_loadu_ps(a + 12);
+    for(int j = 0; j < 16; j += 4)
+    {
+        __m128 r = _mm_mul_ps(a0, _mm_set1_ps(b[j]));
+        r = _mm_add_ps(r, _mm_mul_ps(a1, _mm_set1_ps(b[j+1])));
+        r = _mm_add_ps(r, _mm_mul_ps(a2, _mm_set1_ps(b[j+2])));
+        r = _mm_add_ps(r, _mm_mul_ps(a3, _mm_set1_ps(b[j+3])));
+        _mm_storeu_ps(out + j, r);
+    }
+}
+
+inline void transformVector4Sse(const float a[16], float x, float y, float z, float w, float out[4])
+{
+    __m128 r = _mm_mul_ps(_mm_loadu_ps(a), _mm_set1_ps(x));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(a + 4), _mm_set1_ps(y)));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(a + 8), _mm_set1_ps(z)));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(a + 12), _mm_set1_ps(w)));
+    _mm_storeu_ps(out, r);
+}
+
+// 2 columns of out at once; the columns of a are copied to both halves
+// It needs AVX (not FMA), call it only if detectSimdLevel() >= SIMD_AVX2 or
+// the compiler targets AVX.
+TARGET_AVX
+inline void multiplyMatrix4Avx(const float a[16], const float b[16], float out[16])
+{
+    __m256 a0 = _mm256_broadcast_ps((const __m128*)a);
+    __m256 a1 = _mm256_broadcast_ps((const __m128*)(a + 4));
+    __m256 a2 = _mm256_broadcast_ps((const __m128*)(a + 8));
+    __m256 a3 = _mm256_broadcast_ps((const __m128*)(a + 12));
+    for(int j = 0; j < 16; j += 8)
+    {
+        __m256 n = _mm256_loadu_ps(b + j);
+        __m256 r = _mm256_mul_ps(a0, _mm256_shuffle_ps(n, n, 0x00));
+        r = _mm256_add_ps(r, _mm256_mul_ps(a1, _mm256_shuffle_ps(n, n, 0x55)));
+        r = _mm256_add_ps(r, _mm256_mul_ps(a2, _mm256_shuffle_ps(n, n, 0xaa)));
+        r = _mm256_add_ps(r, _mm256_mul_ps(a3, _mm256_shuffle_ps(n, n, 0xff)));
+        _mm256_storeu_ps(out + j, r);
+    }
+}
+#endif
+
+inline void multiplyMatrix4(const float a[16], const float b[16], float out[16])
+{
+#if defined(CPU_X86) && defined(__AVX__)
+    multiplyMatrix4Avx(a, b, out);
+#elif defined(CPU_X86)
+    multiplyMatrix4Sse(a, b, out);
+#else
+    multiplyMatrix4Scalar(a, b, out);
+#endif
+}
+
+inline void transformVector4(const float a[16], float x, float y, float z, float w, float out[4])
+{
+#ifdef CPU_X86
+    transformVector4Sse(a, x, y, z, w, out);
+#else
+    transformVector4Scalar(a, x, y, z, w, out);
+#endif
+}
+
+
+
 ///////////////////////////////////////////////////////////////////////////
 // inline functions for Matrix4
 ///////////////////////////////////////////////////////////////////////////
@@ -684,6 +819,7 @@ inline void Matrix4::set(const float src[16])
     m[4] = src[4];  m[5] = src[5];  m[6] = src[6];  m[7] = src[7];
     m[8] = src[8];  m[9] = src[9];  m[10]= src[10]; m[11]= src[11];
     m[12]= src[12]; m[13]= src[13]; m[14]= src[14]; m[15]= src[15];
+    kind = KIND_UNKNOWN;
 }
 
 
@@ -697,6 +833,7 @@ inline void Matrix4::set(float m00, float m01, float m02, float m03,
     m[4] = m04;  m[5] = m05;  m[6] = m06;  m[7] = m07;
     m[8] = m08;  m[9] = m09;  m[10]= m10;  m[11]= m11;
     m[12]= m12;  m[13]= m13;  m[14]= m14;  m[15]= m15;
+    kind = KIND_UNKNOWN;
 }
 
 
@@ -704,6 +841,7 @@ inline void Matrix4::set(float m00, float m01, float m02, float m03,
 inline void Matrix4::setRow(int index, const float row[4])
 {
     m[index] = row[0];  m[index + 4] = row[1];  m[index + 8] = row[2];  m[index + 12] = row[3];
+    kind = KIND_UNKNOWN;
 }
 
 
@@ -711,6 +849,7 @@ inline void Matrix4::setRow(int index, const float row[4])
 inline void Matrix4::setRow(int index, const Vector4& v)
 {
     m[index] = v.x;  m[index + 4] = v.y;  m[index + 8] = v.z;  m[index + 12] = v.w;
+    kind = KIND_UNKNOWN;
 }
 
 
@@ -718,6 +857,7 @@ inline void Matrix4::setRow(int index, const Vector4& v)
 inline void Matrix4::setRow(int index, const Vector3& v)
 {
     m[index] = v.x;  m[index + 4] = v.y;  m[index + 8] = v.z;
+    kind = KIND_UNKNOWN;
 }
 
 
@@ -725,6 +865,7 @@ inline void Matrix4::setRow(int index, const Vector3& v)
 inline void Matrix4::setColumn(int index, const float col[4])
 {
     m[index*4] = col[0];  m[index*4 + 1] = col[1];  m[index*4 + 2] = col[2];  m[index*4 + 3] = col[3];
+    kind = KIND_UNKNOWN;
 }
 
 
@@ -732,6 +873,7 @@ inline void Matrix4::setColumn(int index, const float col[4])
 inline void Matrix4::setColumn(int index, const Vector4& v)
 {
     m[index*4] = v.x;  m[index*4 + 1] = v.y;  m[index*4 + 2] = v.z;  m[index*4 + 3] = v.w;
+    kind = KIND_UNKNOWN;
 }
 
 
@@ -739,6 +881,7 @@ inline void Matrix4::setColumn(int index, const Vector4& v)
 inline void Matrix4::setColumn(int index, const Vector3& v)
 {
     m[index*4] = v.x;  m[index*4 + 1] = v.y;  m[index*4 + 2] = v.z;
+    kind = KIND_UNKNOWN;
 }
 
 
@@ -765,6 +908,7 @@ inline Matrix4& Matrix4::identity()
 {
     m[0] = m[5] = m[10] = m[15] = 1.0f;
     m[1] = m[2] = m[3] = m[4] = m[6] = m[7] = m[8] = m[9] = m[11] = m[12] = m[13] = m[14] = 0.0f;
+    kind = KIND_IDENTITY;
     return *this;
 }
 
@@ -796,6 +940,7 @@ inline Matrix4& Matrix4::operator+=(const Matrix4& rhs)
     m[4] += rhs[4];   m[5] += rhs[5];   m[6] += rhs[6];   m[7] += rhs[7];
     m[8] += rhs[8];   m[9] += rhs[9];   m[10]+= rhs[10];  m[11]+= rhs[11];
     m[12]+= rhs[12];  m[13]+= rhs[13];  m[14]+= rhs[14];  m[15]+= rhs[15];
+    kind = KIND_UNKNOWN;
     return *this;
 }
 
@@ -807,6 +952,7 @@ inline Matrix4& Matrix4::operator-=(const Matrix4& rhs)
     m[4] -= rhs[4];   m[5] -= rhs[5];   m[6] -= rhs[6];   m[7] -= rhs[7];
     m[8] -= rhs[8];   m[9] -= rhs[9];   m[10]-= rhs[10];  m[11]-= rhs[11];
     m[12]-= rhs[12];  m[13]-= rhs[13];  m[14]-= rhs[14];  m[15]-= rhs[15];
+    kind = KIND_UNKNOWN;
     return *this;
 }
 
@@ -814,36 +960,39 @@ inline Matrix4& Matrix4::operator-=(const Matrix4& rhs)
 
 inline Vector4 Matrix4::operator*(const Vector4& rhs) const
 {
-    return Vector4(m[0]*rhs.x + m[4]*rhs.y + m[8]*rhs.z  + m[12]*rhs.w,
-                   m[1]*rhs.x + m[5]*rhs.y + m[9]*rhs.z  + m[13]*rhs.w,
-                   m[2]*rhs.x + m[6]*rhs.y + m[10]*rhs.z + m[14]*rhs.w,
-                   m[3]*rhs.x + m[7]*rhs.y + m[11]*rhs.z + m[15]*rhs.w);
+    float v[4];
+    transformVector4(m, rhs.x, rhs.y, rhs.z, rhs.w, v);
+    return Vector4(v[0], v[1], v[2], v[3]);
 }
 
 
 
 inline Vector3 Matrix4::operator*(const Vector3& rhs) const
 {
-    return Vector3(m[0]*rhs.x + m[4]*rhs.y + m[8]*rhs.z + m[12],
-                   m[1]*rhs.x + m[5]*rhs.y + m[9]*rhs.z + m[13],
-                   m[2]*rhs.x + m[6]*rhs.y + m[10]*rhs.z+ m[14]);
+    float v[4];
+    transformVector4(m, rhs.x, rhs.y, rhs.z, 1.0f, v);
+    return Vector3(v[0], v[1], v[2]);
 }
 
 
 
 inline Matrix4 Matrix4::operator*(const Matrix4& n) const
 {
-    return Matrix4(m[0]*n[0]  + m[4]*n[1]  + m[8]*n[2]  + m[12]*n[3],   m[1]*n[0]  + m[5]*n[1]  + m[9]*n[2]  + m[13]*n[3],   m[2]*n[0]  + m[6]*n[1]  + m[10]*n[2]  + m[14]*n[3],   m[3]*n[0]  + m[7]*n[1]  + m[11]*n[2]  + m[15]*n[3],
-                   m[0]*n[4]  + m[4]*n[5]  + m[8]*n[6]  + m[12]*n[7],   m[1]*n[4]  + m[5]*n[5]  + m[9]*n[6]  + m[13]*n[7],   m[2]*n[4]  + m[6]*n[5]  + m[10]*n[6]  + m[14]*n[7],   m[3]*n[4]  + m[7]*n[5]  + m[11]*n[6]  + m[15]*n[7],
-                   m[0]*n[8]  + m[4]*n[9]  + m[8]*n[10] + m[12]*n[11],  m[1]*n[8]  + m[5]*n[9]  + m[9]*n[10] + m[13]*n[11],  m[2]*n[8]  + m[6]*n[9]  + m[10]*n[10] + m[14]*n[11],  m[3]*n[8]  + m[7]*n[9]  + m[11]*n[10] + m[15]*n[11],
-                   m[0]*n[12] + m[4]*n[13] + m[8]*n[14] + m[12]*n[15],  m[1]*n[12] + m[5]*n[13] + m[9]*n[14] + m[13]*n[15],  m[2]*n[12] + m[6]*n[13] + m[10]*n[14] + m[14]*n[15],  m[3]*n[12] + m[7]*n[13] + m[11]*n[14] + m[15]*n[15]);
+    Matrix4 r;
+    multiplyMatrix4(m, n.m, r.m);
+    r.kind = combineKind(kind, n.kind);
+    return r;
 }
 
 
 
 inline Matrix4& Matrix4::operator*=(const Matrix4& rhs)
 {
-    *this = *this * rhs;
+    alignas(16) float r[16];
+    Kind k = combineKind(kind, rhs.kind);
+    multiplyMatrix4(m, rhs.m, r);
+    set(r);
+    kind = k;
     return *this;
 }
 
@@ -878,6 +1027,7 @@ inline float Matrix4::operator[](int index) const
 
 inline float& Matrix4::operator[](int index)
 {
+    kind = KIND_UNKNOWN;                    // may be written, valid until the next call
     return m[index];
 }
 
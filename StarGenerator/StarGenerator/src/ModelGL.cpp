@@ -5,13 +5,15 @@
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2016-02-10
-// UPDATED: 2016-02-25
+// UPDATED: 2026-10-18
 ///////////////////////////////////////////////////////////////////////////////
 
 #ifdef _WIN32
 #include <windows.h>    // include windows.h to avoid thousands of compile errors even though this class is not depending on Windows
 #endif
 
+#include "glExtension.h"    // before gl.h, to get the prototypes of glext.h on Linux
+
 #ifdef __APPLE__
 #include <OpenGL/gl.h>
 #else
@@ -19,20 +21,29 @@
 #include <GL/glu.h>
 #endif
 
+#include <algorithm>
 #include <cmath>
 #include <sstream>
 #include "ModelGL.h"
-#include "glExtension.h"
+#include "FrameProfiler.h"
 
 // constants
 const float GRID_SIZE = 10.0f;
 const float GRID_STEP = 1.0f;
+const int   GRID_MAX_LINES = 500;           // max lines per side of an axis
+const int   GRID_LOD_RATIO = 10;            // step ratio of next coarser level
+const float GRID_FADE_MIN = 4.0f;           // hide lines closer than 4 pixels
+const float GRID_FADE_MAX = 16.0f;          // opaque lines farther than 16 pixels
 const float CAM_DIST = 20.0f;
 const float DEG2RAD = 3.141593f / 180;
 const float FOV_Y = 60.0f;
 const float NEAR_PLANE = 0.1f;
 const float FAR_PLANE = 1000.0f;
 const int   MAX_LOG_LENGTH = 4096;
+const int   MIN_INSTANCE_POINT_COUNT = 4;   // same as Star::setPointCount()
+const int   INSTANCE_FLOAT_COUNT = 8;       // floats per instance
+const GLuint ATTRIB_INSTANCE_TRANSFORM = 1; // x, y, s*cos, s*sin
+const GLuint ATTRIB_INSTANCE_COLOR = 2;     // r, g, b, a
 
 // flat shading ===========================================
 const char* vsSource1 = "\
@@ -50,6 +61,22 @@ void main() \
 ";
 
 
+// instanced star =========================================
+// each instance transforms the unit star mesh by (scale, rotation, position)
+const char* vsSourceInstance = "\
+attribute vec4 instanceTransform; \
+attribute vec4 instanceColor; \
+void main() \
+{ \
+    vec2 v = gl_Vertex.xy; \
+    vec2 p = vec2(instanceTransform.z * v.x - instanceTransform.w * v.y, \
+                  instanceTransform.w * v.x + instanceTransform.z * v.y) + instanceTransform.xy; \
+    gl_FrontColor = instanceColor; \
+    gl_Position = gl_ModelViewProjectionMatrix * vec4(p, 0.0, 1.0); \
+} \
+";
+
+
 // blinn shading ==========================================
 const char* vsSource2 = "\
 varying vec3 esVertex, esNormal; \
@@ -98,8 +125,12 @@ ModelGL::ModelGL() : windowWidth(0), windowHeight(0), mouseLeftDown(false),
                      nearPlane(NEAR_PLANE), farPlane(FAR_PLANE),
                      fillEnabled(true), edgeEnabled(true), pointEnabled(true),
                      gridEnabled(true), gridSize(GRID_SIZE), gridStep(GRID_STEP),
-                     vboSupported(false), vboVertex(0), glslSupported(false),
-                     glslReady(false), progId1(0), progId2(0)
+                     gridAxisFirst(0), gridBuiltSize(0), gridBuiltStep(0), gridValid(false), vboGrid(0),
+                     selectedPoint(-1), vboSupported(false), vboVertex(0), vboIndex(0), vboValid(false),
+                     vboVersion(0), vboIndexVersion(0), vboVertexSize(0), fillIndexCount(0),
+                     edgeIndexCount(0), starPointCount(0), starInstanceCount(0),
+                     instancingSupported(false), progInstance(0), gpuDrawPass(-1),
+                     glslSupported(false), glslReady(false), progId1(0), progId2(0)
 {
     bgColor.set(0, 0, 0, 0);
 
@@ -136,6 +167,8 @@ ModelGL::~ModelGL()
 ///////////////////////////////////////////////////////////////////////////////
 void ModelGL::init()
 {
+    glState.invalidate();                           // new context, states are unknown
+
     glShadeModel(GL_SMOOTH);                        // shading mathod: GL_SMOOTH or GL_FLAT
     glPixelStorei(GL_UNPACK_ALIGNMENT, 4);          // 4-byte pixel alignment
 
@@ -143,11 +176,11 @@ void ModelGL::init()
     glHint(GL_PERSPECTIVE_CORRECTION_HINT, GL_NICEST);
     //glHint(GL_LINE_SMOOTH_HINT, GL_NICEST);
     //glHint(GL_POLYGON_SMOOTH_HINT, GL_NICEST);
-    glEnable(GL_DEPTH_TEST);
-    glEnable(GL_LIGHTING);
+    glState.enable(GL_DEPTH_TEST);
+    glState.enable(GL_LIGHTING);
     //glEnable(GL_TEXTURE_2D);
-    glEnable(GL_CULL_FACE);
-    glEnable(GL_BLEND);
+    glState.enable(GL_CULL_FACE);
+    glState.enable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     glClearColor(bgColor[0], bgColor[1], bgColor[2], bgColor[3]);   // background color
@@ -165,7 +198,16 @@ void ModelGL::init()
 
     vboSupported = extension.isSupported("GL_ARB_vertex_buffer_object");
     if(vboSupported)
-        createVertexBufferObjects();
+        vboSupported = createVertexBufferObjects();
+
+    // instancing needs vertex attribs of shader and VBOs
+    instancingSupported = glslReady && vboSupported &&
+                          extension.isSupported("GL_ARB_draw_instanced") &&
+                          extension.isSupported("GL_ARB_instanced_arrays");
+    if(instancingSupported)
+        instancingSupported = createInstanceShaderProgram();
+
+    gpuTimer.init();
 }
 
 
@@ -175,6 +217,14 @@ void ModelGL::init()
 ///////////////////////////////////////////////////////////////////////////////
 void ModelGL::quit()
 {
+    deleteVertexBufferObjects();
+    deleteStarInstanceBuffers();
+    gpuTimer.quit();
+
+    if(vboGrid)
+        glState.deleteBuffers(1, &vboGrid);
+    vboGrid = 0;
+    gridValid = false;
 }
 
 
@@ -196,7 +246,7 @@ void ModelGL::initLights()
     float lightPos[4] = {0, 0, 1, 0};               // directional light
     glLightfv(GL_LIGHT0, GL_POSITION, lightPos);
 
-    glEnable(GL_LIGHT0);                            // MUST enable each light source after configuration
+    glState.enable(GL_LIGHT0);                            // MUST enable each light source after configuration
 }
 
 
@@ -326,10 +376,15 @@ void ModelGL::setStarSelectedPoint(int index)
 ///////////////////////////////////////////////////////////////////////////////
 void ModelGL::draw()
 {
+    ScopedTimer timer("draw");
     preFrame();
 
     // clear buffer
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+    {
+        ScopedTimer passTimer("clear");
+        glTimerScope gpu(gpuTimer, "clear");
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+    }
 
     // pass projection matrix to OpenGL
     glMatrixMode(GL_PROJECTION);
@@ -339,6 +394,9 @@ void ModelGL::draw()
     // draw grid and axis
     if(gridEnabled)
     {
+        ScopedTimer passTimer("grid");
+        glTimerScope gpu(gpuTimer, "grid");
+
         // copy  the current ModelView matrix to OpenGL after transpose
         glLoadMatrixf(matrixView.get());
         drawGrid(gridSize, gridStep);
@@ -346,7 +404,19 @@ void ModelGL::draw()
 
     // draw star
     glLoadMatrixf(matrixModelView.get());
-    drawStar();
+    if(vboSupported)
+        drawStarWithVbo();
+    else
+        drawStar();
+
+    // draw star instances
+    if(!starGroups.empty() || !staleBuffers.empty())
+    {
+        ScopedTimer passTimer("instances");
+        glTimerScope gpu(gpuTimer, "instances");
+        glLoadMatrixf(matrixView.get());
+        drawStarInstances();
+    }
 
     postFrame();
 }
@@ -355,9 +425,14 @@ void ModelGL::draw()
 
 ///////////////////////////////////////////////////////////////////////////////
 // pre-frame
+// It starts a frame of FrameProfiler, and the GPU timestamps of the frame.
 ///////////////////////////////////////////////////////////////////////////////
 void ModelGL::preFrame()
 {
+    FrameProfiler::getInstance().beginFrame();
+    gpuTimer.beginFrame();
+    gpuDrawPass = gpuTimer.beginPass("draw");
+
     if(windowSizeChanged)
     {
         setViewport(0, 0, windowWidth, windowHeight);
@@ -371,6 +446,8 @@ void ModelGL::preFrame()
 ///////////////////////////////////////////////////////////////////////////////
 void ModelGL::postFrame()
 {
+    gpuTimer.endPass(gpuDrawPass);
+    gpuTimer.endFrame();
 }
 
 
@@ -483,181 +560,545 @@ void ModelGL::setOrthoFrustum(float l, float r, float b, float t, float n, float
 
 ///////////////////////////////////////////////////////////////////////////////
 // draw star
+// The vertices and indices are cached in Star, and rebuilt only when the star
+// is changed, so it draws them as vertex arrays without rebuilding per frame.
 ///////////////////////////////////////////////////////////////////////////////
 void ModelGL::drawStar()
 {
     if(glslReady)
-        glUseProgramObjectARB(progId1);
+        glState.useProgram(progId1);
 
-    glDisable(GL_LIGHTING);
+    glState.disable(GL_LIGHTING);
 
-    int i, j, k;
-    std::vector<Vector2> points = star.getPoints();
+    Star::PointView points = star.getPointView();
     int pointCount = (int)points.size();
 
+    glNormal3f(0, 0, 1);
+    glState.enableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(2, GL_FLOAT, 0, points.data());
+
     // draw triangles
     if(fillEnabled)
     {
+        ScopedTimer passTimer("fill");
+        glTimerScope gpu(gpuTimer, "fill");
+        const std::vector<unsigned int>& indices = star.getFillIndices();
+        glState.enable(GL_DEPTH_TEST);
         glColor3f(0.8f, 0.8f, 0.8f);
-        glNormal3f(0, 0, 1);
-        glBegin(GL_TRIANGLES);
-        for(i = pointCount - 1; i > 0; i -= 2)
-        {
-            j = i - 1;
-            k = i - 2;
-            if(k < 0)
-                k = pointCount - 1;
-
-            glVertex2f(points[i].x, points[i].y);
-            glVertex2f(points[j].x, points[j].y);
-            glVertex2f(points[k].x, points[k].y);
-        }
-        glEnd();
-
-        glBegin(GL_POLYGON);
-        for(i = pointCount - 1; i > 0; i -= 2)
-        {
-            glVertex2f(points[i].x, points[i].y);
-        }
-        glEnd();
+        glDrawElements(GL_TRIANGLES, (GLsizei)indices.size(), GL_UNSIGNED_INT, &indices[0]);
     }
 
     // draw edge lines
     if(edgeEnabled)
     {
-        glDisable(GL_DEPTH_TEST);
-        glLineWidth(3.0f);
+        ScopedTimer passTimer("edges");
+        glTimerScope gpu(gpuTimer, "edges");
+        const std::vector<unsigned int>& indices = star.getEdgeIndices();
+        glState.disable(GL_DEPTH_TEST);
+        glState.lineWidth(3.0f);
         glColor3f(1.0f, 1.0f, 0.0f);
-        glBegin(GL_LINES);
-        for(i = 0; i < pointCount - 1; ++i)
-        {
-            glVertex2f(points[i].x, points[i].y);
-            glVertex2f(points[i+1].x, points[i+1].y);
-        }
-        glVertex2f(points[pointCount-1].x, points[pointCount-1].y);
-        glVertex2f(points[0].x, points[0].y);
-        glEnd();
+        glDrawElements(GL_LINE_LOOP, (GLsizei)indices.size(), GL_UNSIGNED_INT, &indices[0]);
     }
 
     // draw all points
     if(pointEnabled)
     {
-        glPointSize(7);
-        glDisable(GL_DEPTH_TEST);
-        glBegin(GL_POINTS);
+        ScopedTimer passTimer("points");
+        glTimerScope gpu(gpuTimer, "points");
+        glState.pointSize(7);
+        glState.disable(GL_DEPTH_TEST);
         glColor3f(0, 1, 0);
-        glNormal3f(0, 0, 1);
-        for(i = 0; i < pointCount; ++i)
-        {
-            glVertex2f(points[i].x, points[i].y);
-        }
-        glEnd();
+        glDrawArrays(GL_POINTS, 0, pointCount);
 
         // selected point
         if(selectedPoint >= 0)
         {
             glColor3f(1, 0, 0);
-            glPointSize(15);
-            glBegin(GL_POINTS);
-            glVertex2f(points[selectedPoint].x, points[selectedPoint].y);
-            glEnd();
+            glState.pointSize(15);
+            glDrawArrays(GL_POINTS, selectedPoint, 1);
         }
-
-        glPointSize(1);
-        glEnable(GL_DEPTH_TEST);
     }
 
-    glEnable(GL_LIGHTING);
-
-    // reset shader to no-texturing & no-lighting
-    if(glslReady)
-        glUseProgramObjectARB(progId1);
 }
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
 // draw star with VBOs
+// Fill, edge and point passes are drawn from the same vertex buffer, and the
+// buffers are uploaded only when the star is changed. So the # of GL calls
+// per frame does not depend on the # of points.
 ///////////////////////////////////////////////////////////////////////////////
 void ModelGL::drawStarWithVbo()
 {
-    /*
-    glBindBufferARB(GL_ARRAY_BUFFER_ARB, vboVertex);
+    updateVertexBufferObjects();
 
-    glEnableClientState(GL_NORMAL_ARRAY);
-    glEnableClientState(GL_VERTEX_ARRAY);
-    glNormalPointer(GL_FLOAT, stride, (void*)(sizeof(float)*3));
-    glVertexPointer(3, GL_FLOAT, stride, 0);
     if(glslReady)
-        glUseProgramObjectARB(progId2);
+        glState.useProgram(progId1);
 
-    // material
-    if(defaultLightingEnabled)
+    glState.disable(GL_LIGHTING);
+
+    glState.bindBuffer(GL_ARRAY_BUFFER_ARB, vboVertex);
+    glState.bindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, vboIndex);
+    glState.enableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(2, GL_FLOAT, 0, 0);
+    glNormal3f(0, 0, 1);
+
+    // draw triangles
+    if(fillEnabled)
     {
-        glMaterialfv(GL_FRONT, GL_AMBIENT, defaultAmbient);
-        glMaterialfv(GL_FRONT, GL_DIFFUSE, defaultDiffuse);
-        glMaterialfv(GL_FRONT, GL_SPECULAR, defaultSpecular);
-        glMaterialf(GL_FRONT, GL_SHININESS, defaultShininess);
+        ScopedTimer passTimer("fill");
+        glTimerScope gpu(gpuTimer, "fill");
+        glState.enable(GL_DEPTH_TEST);
+        glColor3f(0.8f, 0.8f, 0.8f);
+        glDrawElements(GL_TRIANGLES, fillIndexCount, GL_UNSIGNED_INT, 0);
     }
 
-    glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, vboIndices[i]);
-    glDrawElements(GL_TRIANGLES, obj.getIndexCount(i), GL_UNSIGNED_INT, 0);
+    // draw edge lines, the indices after fill
+    if(edgeEnabled)
+    {
+        ScopedTimer passTimer("edges");
+        glTimerScope gpu(gpuTimer, "edges");
+        glState.disable(GL_DEPTH_TEST);
+        glState.lineWidth(3.0f);
+        glColor3f(1.0f, 1.0f, 0.0f);
+        glDrawElements(GL_LINE_LOOP, edgeIndexCount, GL_UNSIGNED_INT,
+                       (void*)(sizeof(GLuint) * fillIndexCount));
+    }
 
-    glDisableClientState(GL_VERTEX_ARRAY);  // disable vertex arrays
-    glDisableClientState(GL_NORMAL_ARRAY);
-    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    // draw all points
+    if(pointEnabled)
+    {
+        ScopedTimer passTimer("points");
+        glTimerScope gpu(gpuTimer, "points");
+        glState.pointSize(7);
+        glState.disable(GL_DEPTH_TEST);
+        glColor3f(0, 1, 0);
+        glDrawArrays(GL_POINTS, 0, starPointCount);
 
-    glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0);
-    glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
+        // selected point
+        if(selectedPoint >= 0 && selectedPoint < starPointCount)
+        {
+            glColor3f(1, 0, 0);
+            glState.pointSize(15);
+            glDrawArrays(GL_POINTS, selectedPoint, 1);
+        }
+    }
 
-    // reset shader to no-texturing & no-lighting
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// set star instances to draw, replacing the previous ones
+// The instances are grouped by point count, and the transform of each
+// instance (x, y, scale*cos, scale*sin) is computed here, so the vertex shader
+// does not call sin()/cos(). The groups with the same point counts keep their
+// meshes and buffers, only the instance data are uploaded at the next draw.
+///////////////////////////////////////////////////////////////////////////////
+void ModelGL::setStarInstances(const StarInstance* instances, unsigned int count)
+{
+    // sorted point counts of the instances, the scratch keeps its capacity
+    std::vector<unsigned int>& pointCounts = instancePointCounts;
+    pointCounts.clear();
+    for(unsigned int i = 0; i < count; ++i)
+        pointCounts.push_back(std::max(instances[i].pointCount, (unsigned int)MIN_INSTANCE_POINT_COUNT));
+    std::sort(pointCounts.begin(), pointCounts.end());
+
+    // rebuild the group list, reusing the groups of the same point count
+    std::vector<StarInstanceGroup>& groups = instanceGroupScratch;
+    groups.clear();
+    size_t old = 0;
+    for(size_t i = 0; i < pointCounts.size(); )
+    {
+        unsigned int pointCount = pointCounts[i];
+        size_t next = std::upper_bound(pointCounts.begin() + i, pointCounts.end(), pointCount) - pointCounts.begin();
+
+        // groups not used anymore
+        while(old < starGroups.size() && starGroups[old].pointCount < pointCount)
+        {
+            StarInstanceGroup& group = starGroups[old++];
+            staleBuffers.push_back(group.vboVertex);
+            staleBuffers.push_back(group.vboIndex);
+            staleBuffers.push_back(group.vboInstance);
+        }
+
+        groups.push_back(StarInstanceGroup());
+        StarInstanceGroup& group = groups.back();
+        if(old < starGroups.size() && starGroups[old].pointCount == pointCount)
+        {
+            std::swap(group, starGroups[old++]);
+        }
+        else
+        {
+            Star mesh(pointCount, 1);
+            group.pointCount = pointCount;
+            group.vertices = mesh.getPoints();
+            group.indices = mesh.getFillIndices();
+            group.vboVertex = group.vboIndex = group.vboInstance = 0;
+            group.meshUploaded = false;
+        }
+        group.instanceData.clear();
+        group.instanceData.reserve((next - i) * INSTANCE_FLOAT_COUNT);
+        group.instancesUploaded = false;
+        i = next;
+    }
+    for(; old < starGroups.size(); ++old)
+    {
+        staleBuffers.push_back(starGroups[old].vboVertex);
+        staleBuffers.push_back(starGroups[old].vboIndex);
+        staleBuffers.push_back(starGroups[old].vboInstance);
+    }
+    starGroups.swap(groups);
+    groups.clear();
+
+    // fill instance data in the order of input, find the group by binary search
+    for(unsigned int i = 0; i < count; ++i)
+    {
+        const StarInstance& instance = instances[i];
+        unsigned int pointCount = std::max(instance.pointCount, (unsigned int)MIN_INSTANCE_POINT_COUNT);
+        std::vector<StarInstanceGroup>::iterator group =
+            std::lower_bound(starGroups.begin(), starGroups.end(), pointCount,
+                             [](const StarInstanceGroup& g, unsigned int n) { return g.pointCount < n; });
+
+        float angle = instance.angle * DEG2RAD;
+        std::vector<float>& data = group->instanceData;
+        data.push_back(instance.x);
+        data.push_back(instance.y);
+        data.push_back(instance.scale * cosf(angle));
+        data.push_back(instance.scale * sinf(angle));
+        data.insert(data.end(), instance.color, instance.color + 4);
+    }
+
+    starInstanceCount = count;
+}
+
+void ModelGL::clearStarInstances()
+{
+    setStarInstances(0, 0);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// draw star instances
+// Each point count group is drawn with a single glDrawElementsInstancedARB(),
+// the mesh is shared by all instances and the per-instance transform/color
+// advance once per instance with glVertexAttribDivisorARB(). So 100k stars
+// with a few distinct point counts take only a few draw calls.
+///////////////////////////////////////////////////////////////////////////////
+void ModelGL::drawStarInstances()
+{
+    updateStarInstanceBuffers();
+    if(starGroups.empty())
+        return;
+
+    if(!instancingSupported)
+    {
+        drawStarInstancesWithoutInstancing();
+        return;
+    }
+
+    glState.useProgram(progInstance);
+    glState.disable(GL_LIGHTING);
+    glState.enable(GL_DEPTH_TEST);
+
+    glState.enableClientState(GL_VERTEX_ARRAY);
+    glEnableVertexAttribArrayARB(ATTRIB_INSTANCE_TRANSFORM);
+    glEnableVertexAttribArrayARB(ATTRIB_INSTANCE_COLOR);
+    glVertexAttribDivisorARB(ATTRIB_INSTANCE_TRANSFORM, 1);
+    glVertexAttribDivisorARB(ATTRIB_INSTANCE_COLOR, 1);
+
+    const GLsizei stride = sizeof(float) * INSTANCE_FLOAT_COUNT;
+    for(size_t i = 0; i < starGroups.size(); ++i)
+    {
+        const StarInstanceGroup& group = starGroups[i];
+
+        glState.bindBuffer(GL_ARRAY_BUFFER_ARB, group.vboVertex);
+        glVertexPointer(2, GL_FLOAT, 0, 0);
+
+        glState.bindBuffer(GL_ARRAY_BUFFER_ARB, group.vboInstance);
+        glVertexAttribPointerARB(ATTRIB_INSTANCE_TRANSFORM, 4, GL_FLOAT, GL_FALSE, stride, 0);
+        glVertexAttribPointerARB(ATTRIB_INSTANCE_COLOR, 4, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * 4));
+
+        glState.bindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, group.vboIndex);
+        glDrawElementsInstancedARB(GL_TRIANGLES, (GLsizei)group.indices.size(), GL_UNSIGNED_INT, 0,
+                                   (GLsizei)(group.instanceData.size() / INSTANCE_FLOAT_COUNT));
+    }
+
+    glVertexAttribDivisorARB(ATTRIB_INSTANCE_TRANSFORM, 0);
+    glVertexAttribDivisorARB(ATTRIB_INSTANCE_COLOR, 0);
+    glDisableVertexAttribArrayARB(ATTRIB_INSTANCE_TRANSFORM);
+    glDisableVertexAttribArrayARB(ATTRIB_INSTANCE_COLOR);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// draw star instances one by one, if instancing is not supported
+// The meshes are drawn from client memory (or VBOs if supported), and each
+// instance sets its own matrix and color.
+///////////////////////////////////////////////////////////////////////////////
+void ModelGL::drawStarInstancesWithoutInstancing()
+{
     if(glslReady)
-        glUseProgramObjectARB(progId1);
-    */
+        glState.useProgram(progId1);
+
+    glState.disable(GL_LIGHTING);
+    glState.enable(GL_DEPTH_TEST);
+    glState.enableClientState(GL_VERTEX_ARRAY);
+
+    for(size_t i = 0; i < starGroups.size(); ++i)
+    {
+        const StarInstanceGroup& group = starGroups[i];
+        const void* vertices = &group.vertices[0];
+        const void* indices = &group.indices[0];
+        if(vboSupported)
+        {
+            glState.bindBuffer(GL_ARRAY_BUFFER_ARB, group.vboVertex);
+            glState.bindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, group.vboIndex);
+            vertices = indices = 0;
+        }
+        glVertexPointer(2, GL_FLOAT, 0, vertices);
+
+        // (x, y, s*cos, s*sin) as a 2D affine matrix
+        const std::vector<float>& data = group.instanceData;
+        float m[16] = {1,0,0,0, 0,1,0,0, 0,0,1,0, 0,0,0,1};
+        for(size_t j = 0; j < data.size(); j += INSTANCE_FLOAT_COUNT)
+        {
+            m[0] = data[j+2];  m[1] = data[j+3];
+            m[4] = -data[j+3]; m[5] = data[j+2];
+            m[12] = data[j];   m[13] = data[j+1];
+
+            glPushMatrix();
+            glMultMatrixf(m);
+            glColor4fv(&data[j+4]);
+            glDrawElements(GL_TRIANGLES, (GLsizei)group.indices.size(), GL_UNSIGNED_INT, indices);
+            glPopMatrix();
+        }
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// delete the buffers of removed groups, and upload the meshes of new groups
+// and the instance data of changed groups
+///////////////////////////////////////////////////////////////////////////////
+void ModelGL::updateStarInstanceBuffers()
+{
+    if(!vboSupported)
+    {
+        staleBuffers.clear();
+        return;
+    }
+
+    if(!staleBuffers.empty())
+        glState.deleteBuffers((GLsizei)staleBuffers.size(), &staleBuffers[0]);
+    staleBuffers.clear();
+
+    for(size_t i = 0; i < starGroups.size(); ++i)
+    {
+        StarInstanceGroup& group = starGroups[i];
+        if(!group.meshUploaded)
+        {
+            glGenBuffersARB(1, &group.vboVertex);
+            glState.bindBuffer(GL_ARRAY_BUFFER_ARB, group.vboVertex);
+            glBufferDataARB(GL_ARRAY_BUFFER_ARB, sizeof(Vector2) * group.vertices.size(),
+                            &group.vertices[0], GL_STATIC_DRAW_ARB);
+
+            glGenBuffersARB(1, &group.vboIndex);
+            glState.bindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, group.vboIndex);
+            glBufferDataARB(GL_ELEMENT_ARRAY_BUFFER_ARB, sizeof(GLuint) * group.indices.size(),
+                            &group.indices[0], GL_STATIC_DRAW_ARB);
+
+            glGenBuffersARB(1, &group.vboInstance);
+            group.meshUploaded = true;
+        }
+
+        if(!group.instancesUploaded)
+        {
+            glState.bindBuffer(GL_ARRAY_BUFFER_ARB, group.vboInstance);
+            glBufferDataARB(GL_ARRAY_BUFFER_ARB, sizeof(float) * group.instanceData.size(),
+                            &group.instanceData[0], GL_DYNAMIC_DRAW_ARB);
+            group.instancesUploaded = true;
+        }
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// delete the buffers of all star instances
+// The groups are kept, they are uploaded again at the next draw.
+///////////////////////////////////////////////////////////////////////////////
+void ModelGL::deleteStarInstanceBuffers()
+{
+    for(size_t i = 0; i < starGroups.size(); ++i)
+    {
+        staleBuffers.push_back(starGroups[i].vboVertex);
+        staleBuffers.push_back(starGroups[i].vboIndex);
+        staleBuffers.push_back(starGroups[i].vboInstance);
+        starGroups[i].vboVertex = starGroups[i].vboIndex = starGroups[i].vboInstance = 0;
+        starGroups[i].meshUploaded = starGroups[i].instancesUploaded = false;
+    }
+
+    if(vboSupported && !staleBuffers.empty())
+        glState.deleteBuffers((GLsizei)staleBuffers.size(), &staleBuffers[0]);
+    staleBuffers.clear();
 }
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
 // draw a grid on the xy plane
+// The lines are baked once per size/step, and drawn from a VBO (or a vertex
+// array). The levels finer than GRID_FADE_MIN pixels on screen are skipped and
+// the finest visible level fades in, so the # of lines drawn is bounded by
+// the screen, not by the extent of grid.
 ///////////////////////////////////////////////////////////////////////////////
 void ModelGL::drawGrid(float size, float step)
 {
-    glDisable(GL_LIGHTING);
-    glDisable(GL_DEPTH_TEST);
-    glLineWidth(0.5f);
+    if(!gridValid || size != gridBuiltSize || step != gridBuiltStep)
+        buildGrid(size, step);
+    if(gridLevels.empty())
+        return;
+
+    if(glslReady)
+        glState.useProgram(progId1);
+    glState.disable(GL_LIGHTING);
+    glState.disable(GL_DEPTH_TEST);
+    glState.lineWidth(0.5f);
 
-    glBegin(GL_LINES);
+    const GLvoid* vertices = &gridVertices[0];
+    if(vboSupported)
+    {
+        glState.bindBuffer(GL_ARRAY_BUFFER_ARB, vboGrid);
+        vertices = 0;
+    }
+    glState.enableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(2, GL_FLOAT, 0, vertices);
+
+    // the coarsest level is always drawn, then opaque levels are contiguous
+    int last = 0;
+    while(last + 1 < (int)gridLevels.size() && getGridFade(gridLevels[last + 1].step) >= 1.0f)
+        ++last;
 
     glColor4f(0.5f, 0.5f, 0.5f, 0.5f);
-    for(float i=step; i <= size; i+= step)
+    glDrawArrays(GL_LINES, 0, gridLevels[last].first + gridLevels[last].count);
+
+    // fading level
+    if(last + 1 < (int)gridLevels.size())
     {
-        glVertex3f(-size,  i, 0);   // lines parallel to X-axis
-        glVertex3f( size,  i, 0);
-        glVertex3f(-size, -i, 0);   // lines parallel to X-axis
-        glVertex3f( size, -i, 0);
-
-        glVertex3f( i, -size, 0);   // lines parallel to Y-axis
-        glVertex3f( i,  size, 0);
-        glVertex3f(-i, -size, 0);   // lines parallel to Y-axis
-        glVertex3f(-i,  size, 0);
+        const GridLevel& level = gridLevels[last + 1];
+        float fade = getGridFade(level.step);
+        if(fade > 0)
+        {
+            glColor4f(0.5f, 0.5f, 0.5f, 0.5f * fade);
+            glDrawArrays(GL_LINES, level.first, level.count);
+        }
     }
 
     // x-axis
     glColor4f(1.0f, 0, 0, 0.5f);
-    glVertex3f(-size, 0, 0);
-    glVertex3f( size, 0, 0);
+    glDrawArrays(GL_LINES, gridAxisFirst, 2);
 
     // y-axis
     glColor4f(0, 0, 1.0f, 0.5f);
-    glVertex3f(0, -size, 0);
-    glVertex3f(0,  size, 0);
+    glDrawArrays(GL_LINES, gridAxisFirst + 2, 2);
+}
+
 
-    glEnd();
 
-    glLineWidth(1.0f);
-    glEnable(GL_DEPTH_TEST);
-    glEnable(GL_LIGHTING);
+///////////////////////////////////////////////////////////////////////////////
+// build the grid lines, grouped by LOD level from coarse to fine
+// The finest step is increased by GRID_LOD_RATIO until a side has at most
+// GRID_MAX_LINES lines, so a huge grid does not make a huge buffer. A line is
+// in the coarsest level that contains it; the lines are counted in units of
+// the finest step, so there is no rounding error of the positions.
+///////////////////////////////////////////////////////////////////////////////
+void ModelGL::buildGrid(float size, float step)
+{
+    gridVertices.clear();
+    gridLevels.clear();
+    gridBuiltSize = size;
+    gridBuiltStep = step;
+    gridValid = true;
+    if(size <= 0 || step <= 0)
+        return;
+
+    // finest step and # of lines per side
+    double baseStep = step;
+    while(size / baseStep > GRID_MAX_LINES)
+        baseStep *= GRID_LOD_RATIO;
+    int lineCount = (int)(size / baseStep + 0.0001);
+
+    // ratio of each level to the finest, coarse to fine
+    std::vector<int> ratios(1, 1);
+    while(ratios.back() * GRID_LOD_RATIO <= lineCount)
+        ratios.push_back(ratios.back() * GRID_LOD_RATIO);
+    std::reverse(ratios.begin(), ratios.end());
+
+    gridVertices.reserve(lineCount * 16 + 8);
+    for(size_t k = 0; k < ratios.size(); ++k)
+    {
+        GridLevel level;
+        level.step = (float)(baseStep * ratios[k]);
+        level.first = (GLint)(gridVertices.size() / 2);
+
+        for(int n = ratios[k]; n <= lineCount; n += ratios[k])
+        {
+            if(k > 0 && n % ratios[k - 1] == 0)
+                continue;           // in coarser level
+
+            float i = (float)(baseStep * n);
+            float line[16] = {-size,  i,  size,  i,     // lines parallel to X-axis
+                              -size, -i,  size, -i,
+                               i, -size,  i,  size,     // lines parallel to Y-axis
+                              -i, -size, -i,  size};
+            gridVertices.insert(gridVertices.end(), line, line + 16);
+        }
+
+        level.count = (GLsizei)(gridVertices.size() / 2) - level.first;
+        gridLevels.push_back(level);
+    }
+
+    // x-axis and y-axis
+    gridAxisFirst = (GLint)(gridVertices.size() / 2);
+    float axis[8] = {-size, 0, size, 0,
+                     0, -size, 0, size};
+    gridVertices.insert(gridVertices.end(), axis, axis + 8);
+
+    if(vboSupported)
+    {
+        if(!vboGrid)
+            glGenBuffersARB(1, &vboGrid);
+        glState.bindBuffer(GL_ARRAY_BUFFER_ARB, vboGrid);
+        glBufferDataARB(GL_ARRAY_BUFFER_ARB, sizeof(float) * gridVertices.size(),
+                        &gridVertices[0], GL_STATIC_DRAW_ARB);
+        glState.bindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return the alpha scale [0, 1] of grid lines with the step, by the spacing
+// of the lines in pixels at the distance of camera to the origin
+///////////////////////////////////////////////////////////////////////////////
+float ModelGL::getGridFade(float step) const
+{
+    float distance = cameraPosition.length();
+    if(distance <= 0 || windowHeight <= 0)
+        return 1.0f;
+
+    float pixelsPerUnit = windowHeight / (2 * distance * tanf(FOV_Y / 2 * DEG2RAD));
+    float pixels = step * pixelsPerUnit;
+    if(pixels <= GRID_FADE_MIN)
+        return 0;
+    if(pixels >= GRID_FADE_MAX)
+        return 1.0f;
+    return (pixels - GRID_FADE_MIN) / (GRID_FADE_MAX - GRID_FADE_MIN);
 }
 
 
@@ -724,14 +1165,89 @@ void ModelGL::setGridSize(float size)
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// create VBOs
+// create VBOs, the star data are uploaded at the first draw
 ///////////////////////////////////////////////////////////////////////////////
 bool ModelGL::createVertexBufferObjects()
 {
     if(!vboVertex)
         glGenBuffersARB(1, &vboVertex);
+    if(!vboIndex)
+        glGenBuffersARB(1, &vboIndex);
 
-    return true;
+    vboValid = false;
+    return vboVertex != 0 && vboIndex != 0;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// upload the vertices of star if the points are changed, and the indices if
+// the point count is changed
+// The vertex buffer is reallocated only if the size is changed, otherwise
+// the data are replaced with glBufferSubData().
+///////////////////////////////////////////////////////////////////////////////
+void ModelGL::updateVertexBufferObjects()
+{
+    if(vboValid && vboVersion == star.getVersion() && vboIndexVersion == star.getIndexVersion())
+        return;
+
+    if(!vboValid || vboVersion != star.getVersion())
+    {
+        Star::PointView points = star.getPointView();
+        GLsizeiptrARB size = (GLsizeiptrARB)(sizeof(Vector2) * points.size());
+
+        glState.bindBuffer(GL_ARRAY_BUFFER_ARB, vboVertex);
+        if(size != vboVertexSize)
+        {
+            glBufferDataARB(GL_ARRAY_BUFFER_ARB, size, points.data(), GL_DYNAMIC_DRAW_ARB);
+            vboVertexSize = size;
+        }
+        else
+        {
+            glBufferSubDataARB(GL_ARRAY_BUFFER_ARB, 0, size, points.data());
+        }
+        glState.bindBuffer(GL_ARRAY_BUFFER_ARB, 0);
+
+        starPointCount = (GLsizei)points.size();
+        vboVersion = star.getVersion();
+    }
+
+    if(!vboValid || vboIndexVersion != star.getIndexVersion())
+    {
+        const std::vector<unsigned int>& fillIndices = star.getFillIndices();
+        const std::vector<unsigned int>& edgeIndices = star.getEdgeIndices();
+        GLsizeiptrARB fillSize = (GLsizeiptrARB)(sizeof(GLuint) * fillIndices.size());
+        GLsizeiptrARB edgeSize = (GLsizeiptrARB)(sizeof(GLuint) * edgeIndices.size());
+
+        glState.bindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, vboIndex);
+        glBufferDataARB(GL_ELEMENT_ARRAY_BUFFER_ARB, fillSize + edgeSize, 0, GL_STATIC_DRAW_ARB);
+        glBufferSubDataARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0, fillSize, &fillIndices[0]);
+        glBufferSubDataARB(GL_ELEMENT_ARRAY_BUFFER_ARB, fillSize, edgeSize, &edgeIndices[0]);
+        glState.bindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
+
+        fillIndexCount = (GLsizei)fillIndices.size();
+        edgeIndexCount = (GLsizei)edgeIndices.size();
+        vboIndexVersion = star.getIndexVersion();
+    }
+
+    vboValid = true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// delete VBOs
+///////////////////////////////////////////////////////////////////////////////
+void ModelGL::deleteVertexBufferObjects()
+{
+    if(vboVertex)
+        glState.deleteBuffers(1, &vboVertex);
+    if(vboIndex)
+        glState.deleteBuffers(1, &vboIndex);
+
+    vboVertex = vboIndex = 0;
+    vboVertexSize = 0;
+    vboValid = false;
 }
 
 
@@ -781,7 +1297,7 @@ bool ModelGL::createShaderPrograms()
     // link program
     glLinkProgramARB(progId2);
 
-    glUseProgramObjectARB(progId2);
+    glState.useProgram(progId2);
 
     // check status
     int linkStatus1, linkStatus2;
@@ -798,3 +1314,33 @@ bool ModelGL::createShaderPrograms()
 
     return glslReady;
 }
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// create glsl program for star instances
+// The instance attribs are bound to fixed locations before linking, so the
+// draw does not query them.
+///////////////////////////////////////////////////////////////////////////////
+bool ModelGL::createInstanceShaderProgram()
+{
+    GLhandleARB vsId = glCreateShaderObjectARB(GL_VERTEX_SHADER);
+    GLhandleARB fsId = glCreateShaderObjectARB(GL_FRAGMENT_SHADER);
+    progInstance = glCreateProgramObjectARB();
+
+    // fragment shader is same as flat shader
+    glShaderSourceARB(vsId, 1, &vsSourceInstance, NULL);
+    glShaderSourceARB(fsId, 1, &fsSource1, NULL);
+    glCompileShaderARB(vsId);
+    glCompileShaderARB(fsId);
+    glAttachObjectARB(progInstance, vsId);
+    glAttachObjectARB(progInstance, fsId);
+
+    glBindAttribLocationARB(progInstance, ATTRIB_INSTANCE_TRANSFORM, "instanceTransform");
+    glBindAttribLocationARB(progInstance, ATTRIB_INSTANCE_COLOR, "instanceColor");
+    glLinkProgramARB(progInstance);
+
+    int linkStatus;
+    glGetObjectParameterivARB(progInstance, GL_OBJECT_LINK_STATUS_ARB, &linkStatus);
+    return linkStatus == GL_TRUE;
+}
@@ -3,9 +3,13 @@
 // =========
 // Model component of OpenGL
 //
+// Besides the editable star, it draws many star instances, each with own
+// position, scale, rotation, color and point count. The instances with the
+// same point count share a mesh and are drawn with one instanced call.
+//
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2016-02-10
-// UPDATED: 2016-02-25
+// UPDATED: 2026-10-18
 ///////////////////////////////////////////////////////////////////////////////
 
 #ifndef MODEL_GL_H
@@ -27,6 +31,18 @@
 #include "Vectors.h"
 #include "Star.h"
 #include "Line.h"
+#include "glStateCache.h"
+#include "glTimerQuery.h"
+
+// a star instance to draw
+struct StarInstance
+{
+    float x, y;                 // position
+    float scale;                // outer radius
+    float angle;                // rotation in degree
+    float color[4];             // RGBA
+    unsigned int pointCount;    // # of outer points
+};
 
 class ModelGL
 {
@@ -52,6 +68,13 @@ public:
     bool isShaderSupported() const          { return glslSupported; }
     bool isShaderReady() const              { return glslReady; }
     bool isVboSupported() const             { return vboSupported; }
+    bool isInstancingSupported() const      { return instancingSupported; }
+
+    // issued/skipped state changes, reset per frame by caller if needed
+    glStateCache& getStateCache()           { return glState; }
+
+    // GPU time of the passes, recorded into FrameProfiler if it is enabled
+    const glTimerQuery& getTimerQuery() const   { return gpuTimer; }
 
     // toggle options
     void enableGrid()                       { gridEnabled = true; }
@@ -71,7 +94,12 @@ public:
     void setStarInnerRadius(float radius);
     void setStarSelectedPoint(int index);
     float getStarInnerRadius()              { return star.getInnerRadius(); }
-    const std::vector<Vector2>& getStarPoints() { return star.getPoints(); }
+    Star::PointView getStarPoints() const { return star.getPointView(); }
+
+    // star instances, drawn after the editable star
+    void setStarInstances(const StarInstance* instances, unsigned int count);
+    void clearStarInstances();
+    unsigned int getStarInstanceCount() const   { return starInstanceCount; }
 
     // for grid
     void setGridSize(float radius);
@@ -86,7 +114,14 @@ private:
     void postFrame();
     void drawStar();
     void drawStarWithVbo();
+    void drawStarInstances();                       // one call per point count
+    void drawStarInstancesWithoutInstancing();      // fallback, one call per star
+    void updateStarInstanceBuffers();
+    void deleteStarInstanceBuffers();
+    bool createInstanceShaderProgram();
     void drawGrid(float size, float step);          // draw a grid on XZ plane
+    void buildGrid(float size, float step);         // bake grid lines per LOD level
+    float getGridFade(float step) const;            // alpha of grid lines by screen spacing
     void setFrustum(float l, float r, float b, float t, float n, float f);
     void setFrustum(float fovy, float ratio, float n, float f);
     void setOrthoFrustum(float l, float r, float b, float t, float n=-1, float f=1);
@@ -94,6 +129,8 @@ private:
     void updateViewMatrix();
     bool createShaderPrograms();
     bool createVertexBufferObjects();
+    void updateVertexBufferObjects();               // upload star if changed
+    void deleteVertexBufferObjects();
     void logShaders();
 
     // members
@@ -115,6 +152,22 @@ private:
     float gridSize;         // half length of grid
     float gridStep;         // step for next grid line
 
+    // grid geometry, rebuilt only when size or step is changed
+    // The lines are grouped by LOD level, coarse to fine, then the 2 axes.
+    struct GridLevel
+    {
+        float step;         // spacing of lines in this level
+        GLint first;        // first vertex
+        GLsizei count;      // # of vertices
+    };
+    std::vector<float> gridVertices;    // x, y per vertex
+    std::vector<GridLevel> gridLevels;
+    GLint gridAxisFirst;                // first vertex of x-axis, then y-axis
+    float gridBuiltSize;
+    float gridBuiltStep;
+    bool gridValid;                     // the geometry matches gridSize/gridStep
+    GLuint vboGrid;
+
     // star
     Star star;
     int selectedPoint;
@@ -132,8 +185,43 @@ private:
 
     // vbo extensions
     bool vboSupported;
-    GLuint vboVertex;               // vbo for OBJ vertices
-    std::vector<GLuint> vboIndices; // vbo for OBJ indices
+    GLuint vboVertex;               // vbo for star vertices
+    GLuint vboIndex;                // vbo for star indices, fill then edge
+    bool vboValid;                  // the buffers have the star data
+    unsigned int vboVersion;        // Star::getVersion() of the uploaded vertices
+    unsigned int vboIndexVersion;   // Star::getIndexVersion() of the uploaded indices
+    GLsizeiptrARB vboVertexSize;    // allocated bytes of vertex buffer
+    GLsizei fillIndexCount;
+    GLsizei edgeIndexCount;
+    GLsizei starPointCount;
+
+    // instanced stars, grouped by point count
+    struct StarInstanceGroup
+    {
+        unsigned int pointCount;
+        std::vector<Vector2> vertices;          // mesh of radius=1
+        std::vector<unsigned int> indices;      // fill triangles
+        std::vector<float> instanceData;        // x, y, s*cos, s*sin, r, g, b, a
+        GLuint vboVertex;
+        GLuint vboIndex;
+        GLuint vboInstance;
+        bool meshUploaded;
+        bool instancesUploaded;
+    };
+    std::vector<StarInstanceGroup> starGroups;  // sorted by point count
+    std::vector<StarInstanceGroup> instanceGroupScratch;    // reused by setStarInstances()
+    std::vector<unsigned int> instancePointCounts;          // reused by setStarInstances()
+    std::vector<GLuint> staleBuffers;           // to delete at next draw
+    unsigned int starInstanceCount;
+    bool instancingSupported;
+    GLhandleARB progInstance;                   // shader program for instances
+
+    // all state changes go through this cache
+    glStateCache glState;
+
+    // GPU timestamps of the passes
+    glTimerQuery gpuTimer;
+    int gpuDrawPass;                // whole draw, from preFrame() to postFrame()
 
     // glsl extensions
     bool glslSupported;
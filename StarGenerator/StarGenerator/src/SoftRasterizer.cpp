@@ -0,0 +1,566 @@
+///////////////////////////////////////////////////////////////////////////////
+// SoftRasterizer.cpp
+// ==================
+// CPU rasterizer to draw star contours into a RGBA framebuffer without OpenGL
+//
+// polygon: scanline with SUBSAMPLES sub-scanlines per pixel row. The spans of
+//          each sub-scanline (nonzero winding) are accumulated with exact
+//          horizontal coverage, so the edges are anti-aliased in both axes.
+// line:    coverage by the distance from the pixel center to the nearest
+//          segment of the loop, so the joints are not blended twice.
+// point:   round sprite, coverage by the distance to the center.
+// triangle: edge functions at pixel centers without AA (rasterKernels.h),
+//          binned into the tiles by the bbox of each triangle.
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+#include "SoftRasterizer.h"
+#include "Star.h"
+#include "WorkPool.h"
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor
+///////////////////////////////////////////////////////////////////////////////
+SoftRasterizer::SoftRasterizer() : pixels(0), width(0), height(0), stride(0),
+                                   scale(1), offsetX(0), offsetY(0)
+{
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// set the target framebuffer, the pending commands are discarded
+///////////////////////////////////////////////////////////////////////////////
+void SoftRasterizer::setFramebuffer(unsigned char* pixels, int width, int height, int stride)
+{
+    this->pixels = pixels;
+    this->width = (pixels && width > 0) ? width : 0;
+    this->height = (pixels && height > 0) ? height : 0;
+    this->stride = (stride > 0) ? stride : this->width * 4;
+
+    vertices.clear();
+    commands.clear();
+    triangles.clear();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// set mapping from star space to pixel space, for the next commands
+///////////////////////////////////////////////////////////////////////////////
+void SoftRasterizer::setTransform(float scale, float offsetX, float offsetY)
+{
+    this->scale = scale;
+    this->offsetX = offsetX;
+    this->offsetY = offsetY;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// record commands
+///////////////////////////////////////////////////////////////////////////////
+void SoftRasterizer::clear(const float color[4])
+{
+    addCommand(CLEAR, 0, 0, 0, color);
+}
+
+void SoftRasterizer::fillPolygon(const Vector2* points, int count, const float color[4])
+{
+    if(count >= 3)
+        addCommand(FILL, points, count, 0, color);
+}
+
+void SoftRasterizer::drawLineLoop(const Vector2* points, int count, float lineWidth, const float color[4])
+{
+    if(count >= 2 && lineWidth > 0)
+        addCommand(LINE_LOOP, points, count, lineWidth, color);
+}
+
+void SoftRasterizer::drawPoints(const Vector2* points, int count, float pointSize, const float color[4])
+{
+    if(count >= 1 && pointSize > 0)
+        addCommand(POINTS, points, count, pointSize, color);
+}
+
+void SoftRasterizer::fillTriangles(const Vector2* points, int pointCount, const unsigned int* indices,
+                                   int indexCount, const float color[4])
+{
+    if(!pixels || pointCount < 3 || indexCount < 3)
+        return;
+
+    Command cmd;
+    cmd.type = TRIANGLES;
+    cmd.first = (int)triangles.size();
+    cmd.size = 0;
+    for(int i = 0; i < 4; ++i)
+        cmd.color[i] = color[i];
+    cmd.bounds[0] = width;
+    cmd.bounds[1] = height;
+    cmd.bounds[2] = cmd.bounds[3] = 0;
+
+    // transform the points once, the triangles only keep the edge functions
+    const int base = (int)vertices.size();
+    for(int i = 0; i < pointCount; ++i)
+        vertices.push_back(Vector2(points[i].x * scale + offsetX, offsetY - points[i].y * scale));
+    const Vector2* p = &vertices[base];
+
+    RasterTriangle triangle;
+    for(int i = 0; i + 2 < indexCount; i += 3)
+    {
+        unsigned int i0 = indices[i], i1 = indices[i + 1], i2 = indices[i + 2];
+        if(i0 >= (unsigned int)pointCount || i1 >= (unsigned int)pointCount || i2 >= (unsigned int)pointCount)
+            continue;
+        if(!setupTriangle(p[i0].x, p[i0].y, p[i1].x, p[i1].y, p[i2].x, p[i2].y, width, height, triangle))
+            continue;
+
+        triangles.push_back(triangle);
+        cmd.bounds[0] = std::min(cmd.bounds[0], triangle.bounds[0]);
+        cmd.bounds[1] = std::min(cmd.bounds[1], triangle.bounds[1]);
+        cmd.bounds[2] = std::max(cmd.bounds[2], triangle.bounds[2]);
+        cmd.bounds[3] = std::max(cmd.bounds[3], triangle.bounds[3]);
+    }
+    vertices.resize(base);
+
+    cmd.count = (int)triangles.size() - cmd.first;
+    if(cmd.count > 0)
+        commands.push_back(cmd);
+}
+
+void SoftRasterizer::fillStar(const Star& star, const float color[4])
+{
+    Star::PointView points = star.getPointView();
+    fillPolygon(points.data(), (int)points.size(), color);
+}
+
+void SoftRasterizer::fillStarTriangles(const Star& star, const float color[4])
+{
+    Star::PointView points = star.getPointView();
+    const std::vector<unsigned int>& indices = star.getFillIndices();
+    if(!indices.empty())
+        fillTriangles(points.data(), (int)points.size(), &indices[0], (int)indices.size(), color);
+}
+
+void SoftRasterizer::drawStarEdges(const Star& star, float lineWidth, const float color[4])
+{
+    Star::PointView points = star.getPointView();
+    drawLineLoop(points.data(), (int)points.size(), lineWidth, color);
+}
+
+void SoftRasterizer::drawStarPoints(const Star& star, float pointSize, const float color[4])
+{
+    Star::PointView points = star.getPointView();
+    drawPoints(points.data(), (int)points.size(), pointSize, color);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// transform the points into pixel space and store the command with its bbox
+// The commands outside of the framebuffer are dropped.
+///////////////////////////////////////////////////////////////////////////////
+void SoftRasterizer::addCommand(CommandType type, const Vector2* points, int count, float size, const float color[4])
+{
+    if(!pixels)
+        return;
+
+    Command cmd;
+    cmd.type = type;
+    cmd.first = (int)vertices.size();
+    cmd.count = count;
+    cmd.size = size;
+    for(int i = 0; i < 4; ++i)
+        cmd.color[i] = color[i];
+
+    if(type == CLEAR)
+    {
+        cmd.bounds[0] = cmd.bounds[1] = 0;
+        cmd.bounds[2] = width;
+        cmd.bounds[3] = height;
+        commands.push_back(cmd);
+        return;
+    }
+
+    float minX = 0, minY = 0, maxX = 0, maxY = 0;
+    for(int i = 0; i < count; ++i)
+    {
+        Vector2 p(points[i].x * scale + offsetX, offsetY - points[i].y * scale);
+        vertices.push_back(p);
+        if(i == 0 || p.x < minX) minX = p.x;
+        if(i == 0 || p.x > maxX) maxX = p.x;
+        if(i == 0 || p.y < minY) minY = p.y;
+        if(i == 0 || p.y > maxY) maxY = p.y;
+    }
+
+    // AA fringe of half pixel and half of line width or point size
+    float margin = 1 + size * 0.5f;
+    cmd.bounds[0] = std::max(0, (int)std::floor(minX - margin));
+    cmd.bounds[1] = std::max(0, (int)std::floor(minY - margin));
+    cmd.bounds[2] = std::min(width, (int)std::ceil(maxX + margin));
+    cmd.bounds[3] = std::min(height, (int)std::ceil(maxY + margin));
+    if(cmd.bounds[0] >= cmd.bounds[2] || cmd.bounds[1] >= cmd.bounds[3])
+    {
+        vertices.resize(cmd.first);
+        return;
+    }
+
+    commands.push_back(cmd);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// rasterize all commands tile by tile in parallel
+///////////////////////////////////////////////////////////////////////////////
+void SoftRasterizer::flush(WorkPool* pool)
+{
+    if(!pixels || commands.empty())
+    {
+        vertices.clear();
+        commands.clear();
+        triangles.clear();
+        return;
+    }
+
+    const int tileCountX = (width + TILE_SIZE - 1) / TILE_SIZE;
+    const int tileCountY = (height + TILE_SIZE - 1) / TILE_SIZE;
+    if(!pool)
+        pool = &WorkPool::getInstance();
+
+    binCommands(tileCountX, tileCountY);
+
+    pool->parallelFor(tileCountX * tileCountY, 1, [&](unsigned int begin, unsigned int end)
+    {
+        TileScratch scratch;
+        for(unsigned int i = begin; i < end; ++i)
+        {
+            if(bins[i].empty())
+                continue;
+            int x0 = (i % tileCountX) * TILE_SIZE;
+            int y0 = (i / tileCountX) * TILE_SIZE;
+            rasterizeTile(bins[i], x0, y0, std::min(x0 + TILE_SIZE, width), std::min(y0 + TILE_SIZE, height), scratch);
+        }
+    });
+
+    vertices.clear();
+    commands.clear();
+    triangles.clear();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// add the commands to the bins of the tiles they touch, in order
+// The triangles of TRIANGLES command are binned one by one with their bbox.
+///////////////////////////////////////////////////////////////////////////////
+void SoftRasterizer::binCommands(int tileCountX, int tileCountY)
+{
+    bins.resize(tileCountX * tileCountY);
+    for(size_t i = 0; i < bins.size(); ++i)
+        bins[i].clear();
+
+    for(int i = 0; i < (int)commands.size(); ++i)
+    {
+        const Command& cmd = commands[i];
+        if(cmd.type != TRIANGLES)
+        {
+            addToBins(cmd.bounds, i, -1, tileCountX);
+            continue;
+        }
+        for(int j = cmd.first; j < cmd.first + cmd.count; ++j)
+            addToBins(triangles[j].bounds, i, j, tileCountX);
+    }
+}
+
+void SoftRasterizer::addToBins(const int bounds[4], int command, int triangle, int tileCountX)
+{
+    int tx0 = bounds[0] / TILE_SIZE;
+    int ty0 = bounds[1] / TILE_SIZE;
+    int tx1 = (bounds[2] - 1) / TILE_SIZE;
+    int ty1 = (bounds[3] - 1) / TILE_SIZE;
+
+    BinEntry entry = {command, triangle};
+    for(int ty = ty0; ty <= ty1; ++ty)
+    {
+        for(int tx = tx0; tx <= tx1; ++tx)
+            bins[ty * tileCountX + tx].push_back(entry);
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// run the binned commands in order, clipped to the tile [x0, x1) x [y0, y1)
+///////////////////////////////////////////////////////////////////////////////
+void SoftRasterizer::rasterizeTile(const std::vector<BinEntry>& bin, int x0, int y0, int x1, int y1,
+                                   TileScratch& scratch)
+{
+    for(size_t i = 0; i < bin.size(); ++i)
+    {
+        const Command& cmd = commands[bin[i].command];
+        if(cmd.type == TRIANGLES)
+        {
+            rasterizeTriangle(triangles[bin[i].triangle], pixels, stride, x0, y0, x1, y1, cmd.color);
+            continue;
+        }
+
+        int cx0 = std::max(x0, cmd.bounds[0]);
+        int cy0 = std::max(y0, cmd.bounds[1]);
+        int cx1 = std::min(x1, cmd.bounds[2]);
+        int cy1 = std::min(y1, cmd.bounds[3]);
+        if(cx0 >= cx1 || cy0 >= cy1)
+            continue;
+
+        switch(cmd.type)
+        {
+        case CLEAR:
+            clearTile(cmd, cx0, cy0, cx1, cy1);
+            break;
+        case FILL:
+            fillTile(cmd, cx0, cy0, cx1, cy1, scratch);
+            break;
+        case LINE_LOOP:
+            drawLineLoopTile(cmd, cx0, cy0, cx1, cy1, scratch);
+            break;
+        case POINTS:
+            drawPointsTile(cmd, cx0, cy0, cx1, cy1);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// overwrite the pixels with the color
+///////////////////////////////////////////////////////////////////////////////
+void SoftRasterizer::clearTile(const Command& cmd, int x0, int y0, int x1, int y1)
+{
+    unsigned char color[4];
+    for(int i = 0; i < 4; ++i)
+        color[i] = (unsigned char)(std::min(std::max(cmd.color[i], 0.0f), 1.0f) * 255 + 0.5f);
+
+    for(int y = y0; y < y1; ++y)
+    {
+        unsigned char* pixel = pixels + (size_t)y * stride + x0 * 4;
+        for(int x = x0; x < x1; ++x, pixel += 4)
+        {
+            pixel[0] = color[0];
+            pixel[1] = color[1];
+            pixel[2] = color[2];
+            pixel[3] = color[3];
+        }
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// fill polygon with nonzero winding rule
+///////////////////////////////////////////////////////////////////////////////
+void SoftRasterizer::fillTile(const Command& cmd, int x0, int y0, int x1, int y1, TileScratch& scratch)
+{
+    const Vector2* points = &vertices[cmd.first];
+    const int count = cmd.count;
+    const float weight = 1.0f / SUBSAMPLES;
+
+    std::vector<float>& coverage = scratch.coverage;
+    std::vector<Crossing>& crossings = scratch.crossings;
+    coverage.resize(x1 - x0);
+
+    for(int y = y0; y < y1; ++y)
+    {
+        std::fill(coverage.begin(), coverage.end(), 0.0f);
+        bool covered = false;
+
+        for(int s = 0; s < SUBSAMPLES; ++s)
+        {
+            float sy = y + (s + 0.5f) * weight;
+
+            // crossings of all edges with the sub-scanline
+            crossings.clear();
+            for(int i = 0, j = count - 1; i < count; j = i++)
+            {
+                const Vector2& a = points[j];
+                const Vector2& b = points[i];
+                if((a.y <= sy) == (b.y <= sy))
+                    continue;
+
+                Crossing crossing;
+                crossing.x = a.x + (sy - a.y) * (b.x - a.x) / (b.y - a.y);
+                crossing.winding = (b.y > a.y) ? 1 : -1;
+                crossings.push_back(crossing);
+            }
+
+            // sort by x, only a few crossings per scanline
+            for(size_t i = 1; i < crossings.size(); ++i)
+            {
+                Crossing crossing = crossings[i];
+                size_t j = i;
+                for(; j > 0 && crossings[j - 1].x > crossing.x; --j)
+                    crossings[j] = crossings[j - 1];
+                crossings[j] = crossing;
+            }
+
+            // spans where winding is not zero
+            int winding = 0;
+            float start = 0;
+            for(size_t i = 0; i < crossings.size(); ++i)
+            {
+                int prev = winding;
+                winding += crossings[i].winding;
+                if(prev == 0 && winding != 0)
+                {
+                    start = crossings[i].x;
+                    continue;
+                }
+                if(prev == 0 || winding != 0)
+                    continue;
+
+                // add span [start, end) clipped to the tile
+                float a = std::max(start, (float)x0);
+                float b = std::min(crossings[i].x, (float)x1);
+                if(a >= b)
+                    continue;
+
+                int ia = (int)a;
+                int ib = (int)b;
+                covered = true;
+                if(ia == ib)
+                {
+                    coverage[ia - x0] += (b - a) * weight;
+                    continue;
+                }
+                coverage[ia - x0] += (ia + 1 - a) * weight;
+                for(int x = ia + 1; x < ib; ++x)
+                    coverage[x - x0] += weight;
+                if(ib < x1)
+                    coverage[ib - x0] += (b - ib) * weight;
+            }
+        }
+
+        if(!covered)
+            continue;
+
+        unsigned char* pixel = pixels + (size_t)y * stride + x0 * 4;
+        for(int x = x0; x < x1; ++x, pixel += 4)
+        {
+            float c = coverage[x - x0];
+            if(c > 0)
+                blendPixel(pixel, cmd.color, std::min(c, 1.0f));
+        }
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// draw closed polyline with the width
+// Each segment writes its coverage into the tile buffer only within its own
+// bbox, keeping the max of the overlapping segments, then the pixels are
+// blended once.
+///////////////////////////////////////////////////////////////////////////////
+void SoftRasterizer::drawLineLoopTile(const Command& cmd, int x0, int y0, int x1, int y1, TileScratch& scratch)
+{
+    const Vector2* points = &vertices[cmd.first];
+    const int count = cmd.count;
+    const float reach = cmd.size * 0.5f + 0.5f;    // distance of zero coverage
+    const int tileWidth = x1 - x0;
+
+    std::vector<float>& coverage = scratch.coverage;
+    coverage.assign(tileWidth * (y1 - y0), 0.0f);
+    bool covered = false;
+
+    for(int i = 0; i < count; ++i)
+    {
+        const Vector2& a = points[i];
+        const Vector2& b = points[(i + 1) % count];
+        int sx0 = std::max(x0, (int)std::floor(std::min(a.x, b.x) - reach));
+        int sy0 = std::max(y0, (int)std::floor(std::min(a.y, b.y) - reach));
+        int sx1 = std::min(x1, (int)std::ceil(std::max(a.x, b.x) + reach));
+        int sy1 = std::min(y1, (int)std::ceil(std::max(a.y, b.y) + reach));
+        if(sx0 >= sx1 || sy0 >= sy1)
+            continue;
+
+        float dx = b.x - a.x;
+        float dy = b.y - a.y;
+        float lengthSq = dx * dx + dy * dy;
+        float invLengthSq = (lengthSq > 0) ? 1 / lengthSq : 0;
+
+        for(int y = sy0; y < sy1; ++y)
+        {
+            float py = y + 0.5f - a.y;
+            float* row = &coverage[(y - y0) * tileWidth];
+            for(int x = sx0; x < sx1; ++x)
+            {
+                // distance from pixel center to the segment
+                float px = x + 0.5f - a.x;
+                float t = std::min(std::max((px * dx + py * dy) * invLengthSq, 0.0f), 1.0f);
+                float ex = t * dx - px;
+                float ey = t * dy - py;
+                float c = reach - std::sqrt(ex * ex + ey * ey);
+                if(c > row[x - x0])
+                {
+                    row[x - x0] = c;
+                    covered = true;
+                }
+            }
+        }
+    }
+
+    if(!covered)
+        return;
+
+    for(int y = y0; y < y1; ++y)
+    {
+        const float* row = &coverage[(y - y0) * tileWidth];
+        unsigned char* pixel = pixels + (size_t)y * stride + x0 * 4;
+        for(int x = 0; x < tileWidth; ++x, pixel += 4)
+        {
+            if(row[x] > 0)
+                blendPixel(pixel, cmd.color, std::min(row[x], 1.0f));
+        }
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// draw round points with the diameter
+///////////////////////////////////////////////////////////////////////////////
+void SoftRasterizer::drawPointsTile(const Command& cmd, int x0, int y0, int x1, int y1)
+{
+    const Vector2* points = &vertices[cmd.first];
+    const float radius = cmd.size * 0.5f;
+    const float reach = radius + 0.5f;
+
+    for(int i = 0; i < cmd.count; ++i)
+    {
+        const Vector2& p = points[i];
+        int px0 = std::max(x0, (int)std::floor(p.x - reach));
+        int py0 = std::max(y0, (int)std::floor(p.y - reach));
+        int px1 = std::min(x1, (int)std::ceil(p.x + reach));
+        int py1 = std::min(y1, (int)std::ceil(p.y + reach));
+
+        for(int y = py0; y < py1; ++y)
+        {
+            float dy = y + 0.5f - p.y;
+            unsigned char* pixel = pixels + (size_t)y * stride + px0 * 4;
+            for(int x = px0; x < px1; ++x, pixel += 4)
+            {
+                float dx = x + 0.5f - p.x;
+                float c = reach - std::sqrt(dx * dx + dy * dy);
+                if(c > 0)
+                    blendPixel(pixel, cmd.color, std::min(c, 1.0f));
+            }
+        }
+    }
+}
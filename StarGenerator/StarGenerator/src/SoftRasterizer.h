@@ -0,0 +1,150 @@
+///////////////////////////////////////////////////////////////////////////////
+// SoftRasterizer.h
+// ================
+// CPU rasterizer to draw star contours into a RGBA framebuffer without OpenGL
+// It draws the same passes as ModelGL::drawStar(); anti-aliased polygon fill,
+// anti-aliased thick edge lines and round point sprites, and blends them like
+// glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA).
+//
+// The draw calls only record commands. flush() splits the framebuffer into
+// TILE_SIZE x TILE_SIZE tiles and rasterizes the tiles in parallel with
+// WorkPool; each tile runs the commands in order, so the result is same as
+// drawing them one by one. To render many small icons, call flush() per icon
+// from WorkPool::parallelFor() instead; the nested tiles run serially on the
+// worker, and the icons scale with the cores.
+//
+// fillTriangles() draws triangle lists without AA with the SIMD edge function
+// kernels of rasterKernels.h, for the fan topology of ModelGL::drawStar()
+// (fillStarTriangles). The triangles are set up when recorded, and flush()
+// bins them into the tiles they touch, so each tile only visits its own
+// triangles. The shared edges follow the top-left rule, so a translucent fill
+// has no seams or double-blended pixels.
+//
+// The star space is mapped to pixels by setTransform(); y-axis is up, and
+// pixel (0, 0) is the top-left corner of the framebuffer.
+//
+// usage:
+//   SoftRasterizer raster;
+//   raster.setFramebuffer(pixels, 64, 64);
+//   raster.setTransform(6, 32, 32);     // radius 5 star fits in 64x64
+//   raster.clear(bgColor);
+//   raster.fillStar(star, fillColor);
+//   raster.drawStarEdges(star, 3, edgeColor);
+//   raster.flush();
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef SOFT_RASTERIZER_H_DEF
+#define SOFT_RASTERIZER_H_DEF
+
+#include <vector>
+#include "Vectors.h"
+#include "rasterKernels.h"
+
+class Star;
+class WorkPool;
+
+class SoftRasterizer
+{
+public:
+    static const int TILE_SIZE = 64;                // tile width/height in pixels
+    static const int SUBSAMPLES = 4;                // sub-scanlines per pixel for polygon AA
+
+    SoftRasterizer();
+    ~SoftRasterizer() {}
+
+    // RGBA8 framebuffer owned by caller, stride in bytes (0: width*4)
+    void setFramebuffer(unsigned char* pixels, int width, int height, int stride=0);
+    int getWidth() const                            { return width; }
+    int getHeight() const                           { return height; }
+
+    // pixel = (x * scale + offsetX, offsetY - y * scale)
+    void setTransform(float scale, float offsetX, float offsetY);
+
+    // commands, colors are RGBA in [0, 1]
+    void clear(const float color[4]);
+    void fillPolygon(const Vector2* points, int count, const float color[4]);   // nonzero winding
+    void drawLineLoop(const Vector2* points, int count, float lineWidth, const float color[4]);
+    void drawPoints(const Vector2* points, int count, float pointSize, const float color[4]);
+    void fillTriangles(const Vector2* points, int pointCount, const unsigned int* indices, int indexCount,
+                       const float color[4]);                                  // GL_TRIANGLES, no AA
+
+    // star passes of ModelGL::drawStar()
+    void fillStar(const Star& star, const float color[4]);
+    void drawStarEdges(const Star& star, float lineWidth, const float color[4]);
+    void drawStarPoints(const Star& star, float pointSize, const float color[4]);
+    void fillStarTriangles(const Star& star, const float color[4]);        // fan of getFillIndices()
+
+    // rasterize all commands and clear the command list
+    // pool=0 uses the shared WorkPool
+    void flush(WorkPool* pool=0);
+
+protected:
+
+private:
+    enum CommandType
+    {
+        CLEAR,
+        FILL,
+        LINE_LOOP,
+        POINTS,
+        TRIANGLES
+    };
+
+    struct Command
+    {
+        CommandType type;
+        int first;                                  // first vertex, or triangle for TRIANGLES
+        int count;                                  // # of vertices or triangles
+        float size;                                 // line width or point size
+        float color[4];
+        int bounds[4];                              // pixel bbox: x0, y0, x1, y1 (exclusive)
+    };
+
+    // command, or a triangle of TRIANGLES command, touching a tile
+    struct BinEntry
+    {
+        int command;
+        int triangle;                               // -1: all of command
+    };
+
+    // edge crossing a sub-scanline
+    struct Crossing
+    {
+        float x;
+        int winding;                                // +1 or -1
+    };
+
+    // per-thread buffers, reused for all commands of tiles
+    struct TileScratch
+    {
+        std::vector<float> coverage;                // a row or all pixels of the tile
+        std::vector<Crossing> crossings;
+    };
+
+    void addCommand(CommandType type, const Vector2* points, int count, float size, const float color[4]);
+    void binCommands(int tileCountX, int tileCountY);
+    void addToBins(const int bounds[4], int command, int triangle, int tileCountX);
+    void rasterizeTile(const std::vector<BinEntry>& bin, int x0, int y0, int x1, int y1, TileScratch& scratch);
+    void clearTile(const Command& cmd, int x0, int y0, int x1, int y1);
+    void fillTile(const Command& cmd, int x0, int y0, int x1, int y1, TileScratch& scratch);
+    void drawLineLoopTile(const Command& cmd, int x0, int y0, int x1, int y1, TileScratch& scratch);
+    void drawPointsTile(const Command& cmd, int x0, int y0, int x1, int y1);
+
+    unsigned char* pixels;
+    int width;
+    int height;
+    int stride;
+    float scale;
+    float offsetX;
+    float offsetY;
+
+    std::vector<Vector2> vertices;                  // in pixel space
+    std::vector<Command> commands;
+    std::vector<RasterTriangle> triangles;          // set up by fillTriangles()
+    std::vector<std::vector<BinEntry> > bins;       // per tile, reused by flush()
+};
+
+#endif
@@ -7,29 +7,107 @@
 // Star object can be created with given radius. Then, the top point will be
 // (0, radius).
 //
-// Dependencies: Vector2, Vector3
+// The points are stored either as an array of Vector2 (LAYOUT_AOS, default),
+// or as separate x[] and y[] arrays aligned at 32-byte (LAYOUT_SOA). The other
+// layout and the 3D points are built on demand when the getters are called.
+//
+// The indexed mesh for rendering (triangles for fill and line loop for
+// edges) is built on demand once per point count, in stable order, so a
+// renderer can upload it once and check the version counters for changes.
+//
+// The setters mark the changed fields dirty, and only the minimal update is
+// done; the contour of radius=1 is shared from StarContourCache, so changing
+// the radius is a scale of it, and the same point count is not generated
+// again by any star.
+//
+// The storage of current layout is either owned (points or pointsX/pointsY)
+// or external (the buffer of the caller or StarArena). The views on demand
+// are always owned; a star of the arena registers itself to the arena when it
+// allocates them, so StarArena::reset() can destroy it.
+//
+// Dependencies: Vector2, Vector3, AlignedArray, AngleStepper, pointKernels,
+//               StarContourCache, StarArena
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2016-01-13
-// UPDATED: 2016-03-14
+// UPDATED: 2026-10-18
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "Star.h"
+#include "AngleStepper.h"
 #include "Line.h"
+#include "StarArena.h"
+#include "StarContourCache.h"
+#include "pointKernels.h"
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 #include <iostream>
+#include <stdexcept>
+#include <utility>
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// ctor
+// ctors
 ///////////////////////////////////////////////////////////////////////////////
-Star::Star(unsigned int pointCount, float radius) : innerRadius(0)
+Star::Star(unsigned int pointCount, float radius, Layout layout) : pointCount(0), radius(0),
+                                                                   innerRadius(0), mode(GENERATE_CLOSED_FORM),
+                                                                   layout(layout), dirty(0), contour(0),
+                                                                   externalPoints(0), externalX(0), externalY(0),
+                                                                   externalCapacity(0), arena(0), tracked(false),
+                                                                   pointsValid(false), pointsSoaValid(false),
+                                                                   points3DValid(false), indexPointCount(0),
+                                                                   version(0), indexVersion(0)
+{
+    set(pointCount, radius);
+}
+
+// the points are stored in the buffer of the caller while 2N <= capacity
+Star::Star(Vector2* buffer, unsigned int capacity, unsigned int pointCount, float radius)
+    : pointCount(0), radius(0), innerRadius(0), mode(GENERATE_CLOSED_FORM),
+      layout(LAYOUT_AOS), dirty(0), contour(0),
+      externalPoints(buffer), externalX(0), externalY(0),
+      externalCapacity(buffer ? capacity : 0), arena(0), tracked(false),
+      pointsValid(false), pointsSoaValid(false), points3DValid(false),
+      indexPointCount(0), version(0), indexVersion(0)
 {
     set(pointCount, radius);
 }
 
+// the points are allocated from the arena
+Star::Star(StarArena* arena, unsigned int pointCount, float radius, Layout layout)
+    : pointCount(0), radius(0), innerRadius(0), mode(GENERATE_CLOSED_FORM),
+      layout(layout), dirty(0), contour(0),
+      externalPoints(0), externalX(0), externalY(0),
+      externalCapacity(0), arena(arena), tracked(false),
+      pointsValid(false), pointsSoaValid(false), points3DValid(false),
+      indexPointCount(0), version(0), indexVersion(0)
+{
+    set(pointCount, radius);
+}
+
+// the copy owns its points
+Star::Star(const Star& rhs) : pointCount(0), radius(0), innerRadius(0), mode(GENERATE_CLOSED_FORM),
+                              layout(rhs.layout), dirty(0), contour(0),
+                              externalPoints(0), externalX(0), externalY(0),
+                              externalCapacity(0), arena(0), tracked(false),
+                              pointsValid(false), pointsSoaValid(false), points3DValid(false),
+                              indexPointCount(0), version(0), indexVersion(0)
+{
+    *this = rhs;
+}
+
+Star::Star(Star&& rhs) noexcept : pointCount(0), radius(0), innerRadius(0), mode(GENERATE_CLOSED_FORM),
+                                  layout(rhs.layout), dirty(0), contour(0),
+                                  externalPoints(0), externalX(0), externalY(0),
+                                  externalCapacity(0), arena(0), tracked(false),
+                                  pointsValid(false), pointsSoaValid(false), points3DValid(false),
+                                  indexPointCount(0), version(0), indexVersion(0)
+{
+    *this = std::move(rhs);
+}
+
 
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -40,6 +118,111 @@ Star::~Star()
 }
 
 
+
+///////////////////////////////////////////////////////////////////////////////
+// copy the points into the storage of this star, the views are rebuilt on
+// demand
+///////////////////////////////////////////////////////////////////////////////
+Star& Star::operator=(const Star& rhs)
+{
+    if(this == &rhs)
+        return *this;
+
+    if(layout != rhs.layout)
+    {
+        // drop the storage of the other layout
+        if(rhs.layout == LAYOUT_SOA)
+        {
+            std::vector<Vector2>().swap(points);
+        }
+        else
+        {
+            pointsX.clear();
+            pointsY.clear();
+        }
+        externalPoints = 0;
+        externalX = externalY = 0;
+        externalCapacity = 0;
+        layout = rhs.layout;
+    }
+    pointCount = rhs.pointCount;
+    radius = rhs.radius;
+    innerRadius = rhs.innerRadius;
+    mode = rhs.mode;
+    dirty = rhs.dirty;
+    resizePoints();
+
+    // share the contour, a star of the arena has no owner of it
+    std::shared_ptr<const StarContour> shared = rhs.unitContour;
+    if(!shared && rhs.contour)
+        shared = StarContourCache::getInstance().get(rhs.contour->pointCount, rhs.contour->mode);
+    contour = shared.get();
+    if(arena)
+        arena->pin(shared);
+    else
+        unitContour = shared;
+
+    unsigned int count = 2 * pointCount;
+    if(layout == LAYOUT_AOS)
+    {
+        std::copy(rhs.getAosStorage(), rhs.getAosStorage() + count, getAosStorage());
+    }
+    else
+    {
+        std::copy(rhs.getSoaStorageX(), rhs.getSoaStorageX() + count, getSoaStorageX());
+        std::copy(rhs.getSoaStorageY(), rhs.getSoaStorageY() + count, getSoaStorageY());
+    }
+    invalidateViews();
+    indexPointCount = 0;
+    version = rhs.version;
+    indexVersion = rhs.indexVersion;
+    return *this;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// take the owned memory of rhs, or copy if either star has external storage
+// It is noexcept, so std::vector<Star> moves the stars when it grows. The
+// fallback copy may still allocate (the points of a heap star, or a pin of the
+// arena), then an allocation failure terminates.
+///////////////////////////////////////////////////////////////////////////////
+Star& Star::operator=(Star&& rhs) noexcept
+{
+    if(this == &rhs)
+        return *this;
+
+    if(arena || externalPoints || rhs.arena || rhs.externalPoints)
+        return *this = static_cast<const Star&>(rhs);
+
+    pointCount = rhs.pointCount;
+    radius = rhs.radius;
+    innerRadius = rhs.innerRadius;
+    mode = rhs.mode;
+    layout = rhs.layout;
+    dirty = rhs.dirty;
+    unitContour.swap(rhs.unitContour);
+    contour = rhs.contour;
+    points.swap(rhs.points);
+    pointsX.swap(rhs.pointsX);
+    pointsY.swap(rhs.pointsY);
+    points3D.swap(rhs.points3D);
+    pointsValid = rhs.pointsValid;
+    pointsSoaValid = rhs.pointsSoaValid;
+    points3DValid = rhs.points3DValid;
+    fillIndices.swap(rhs.fillIndices);
+    edgeIndices.swap(rhs.edgeIndices);
+    indexPointCount = rhs.indexPointCount;
+    version = rhs.version;
+    indexVersion = rhs.indexVersion;
+
+    // rhs has the old memory of this star, it is rebuilt if rhs is used again
+    rhs.contour = rhs.unitContour.get();
+    rhs.pointCount = rhs.indexPointCount = 0;
+    return *this;
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // define a star with the # of outer points and radius
 ///////////////////////////////////////////////////////////////////////////////
@@ -50,6 +233,7 @@ void Star::set(unsigned int pointCount, float radius)
         return;
 
     this->radius = radius;
+    dirty |= DIRTY_RADIUS;
     setPointCount(pointCount);
 }
 
@@ -64,13 +248,16 @@ void Star::setPointCount(unsigned int pointCount)
     // min count is 4
     if(pointCount < 4)
         pointCount = 4;
-    else
-        this->pointCount = pointCount;
-
-    points.resize(this->pointCount * 2);
-    points3D.resize(this->pointCount * 2);
 
-    generatePoints();
+    // the unit contour is reused if the count is not changed
+    if(this->pointCount != pointCount)
+    {
+        this->pointCount = pointCount;
+        resizePoints();
+        ++indexVersion;
+    }
+    dirty |= DIRTY_POINT_COUNT;
+    updatePoints();
 }
 
 
@@ -84,13 +271,184 @@ void Star::setRadius(float radius)
         return;
 
     this->radius = radius;
-    generatePoints();
+    dirty |= DIRTY_RADIUS;
+    updatePoints();
 }
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// generate N-pointed star with given radius
+// convert the storage of the points to the given layout
+// The storage of the previous layout is released.
+///////////////////////////////////////////////////////////////////////////////
+void Star::setLayout(Layout layout)
+{
+    if(this->layout == layout)
+        return;
+
+    unsigned int count = 2 * pointCount;
+    if(layout == LAYOUT_SOA)
+    {
+        if(arena)
+        {
+            // new storage from the arena
+            float* x = arena->allocateFloats(count);
+            float* y = arena->allocateFloats(count);
+            const Vector2* src = getAosStorage();
+            for(unsigned int i = 0; i < count; ++i)
+            {
+                x[i] = src[i].x;
+                y[i] = src[i].y;
+            }
+            externalX = x;
+            externalY = y;
+            externalCapacity = count;
+        }
+        else
+        {
+            getPointsX();                   // build SoA from AoS
+            externalCapacity = 0;           // the buffer of caller is AoS only
+        }
+        externalPoints = 0;
+        std::vector<Vector2>().swap(points);
+    }
+    else
+    {
+        if(arena)
+        {
+            Vector2* p = arena->allocatePoints(count);
+            const float* x = getSoaStorageX();
+            const float* y = getSoaStorageY();
+            for(unsigned int i = 0; i < count; ++i)
+                p[i].set(x[i], y[i]);
+            externalPoints = p;
+            externalCapacity = count;
+        }
+        else
+        {
+            getPoints();                    // build AoS from SoA
+        }
+        externalX = externalY = 0;
+        pointsX.clear();
+        pointsY.clear();
+    }
+
+    this->layout = layout;
+    invalidateViews();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// resize the storage of current layout for 2*N points
+///////////////////////////////////////////////////////////////////////////////
+void Star::resizePoints()
+{
+    unsigned int count = 2 * pointCount;
+    if(arena)
+    {
+        // the previous storage is left in the arena until reset()
+        if(count > externalCapacity)
+        {
+            if(layout == LAYOUT_AOS)
+            {
+                externalPoints = arena->allocatePoints(count);
+            }
+            else
+            {
+                externalX = arena->allocateFloats(count);
+                externalY = arena->allocateFloats(count);
+            }
+            externalCapacity = count;
+        }
+    }
+    else if(layout == LAYOUT_AOS)
+    {
+        // move to the heap if the buffer of caller is too small
+        if(externalPoints && count > externalCapacity)
+        {
+            externalPoints = 0;
+            externalCapacity = 0;
+        }
+        if(!externalPoints)
+            points.resize(count);
+    }
+    else
+    {
+        pointsX.resize(count);
+        pointsY.resize(count);
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// the points of current layout are changed, so the other views are outdated
+///////////////////////////////////////////////////////////////////////////////
+void Star::invalidateViews()
+{
+    pointsValid = (layout == LAYOUT_AOS && !externalPoints);
+    pointsSoaValid = (layout == LAYOUT_SOA);
+    points3DValid = false;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// update the points with minimal work for the changed fields
+// - pointCount: get the unit contour (radius=1) from the cache only if it is
+//               not the same count and mode as before, then scale it
+// - radius:     scale the unit contour (inner radius is reset)
+// - innerRadius:rescale inner points only
+///////////////////////////////////////////////////////////////////////////////
+void Star::updatePoints()
+{
+    if(pointCount == 0 || dirty == 0)
+        return;
+
+    if(dirty & DIRTY_POINT_COUNT)
+    {
+        if(!contour || contour->pointCount != pointCount || contour->mode != mode)
+        {
+            std::shared_ptr<const StarContour> shared = StarContourCache::getInstance().get(pointCount, mode);
+            contour = shared.get();
+            if(arena)
+                arena->pin(shared);
+            else
+                unitContour = shared;
+        }
+        dirty |= DIRTY_RADIUS;
+    }
+
+    if(dirty & DIRTY_RADIUS)
+    {
+        const float* unit = &contour->points[0].x;
+        if(layout == LAYOUT_AOS)
+            scalePoints(unit, &getAosStorage()->x, 4 * pointCount, radius);
+        else
+            scalePoints(unit, getSoaStorageX(), getSoaStorageY(), 2 * pointCount, radius);
+        innerRadius = contour->innerRadius * radius;
+    }
+    else if(dirty & DIRTY_INNER_RADIUS)
+    {
+        if(layout == LAYOUT_AOS)
+            scaleInnerPoints(pointCount, innerRadius, getAosStorage());
+        else
+            scaleInnerPoints(pointCount, innerRadius, getSoaStorageX(), getSoaStorageY());
+    }
+
+    dirty = 0;
+    invalidateViews();
+    ++version;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// generate N-pointed star with given radius into the buffer of 2*N points,
+// and return the radius of inner points
+// The buffer is not owned by Star, so it can be a part of a large contiguous
+// array (see StarBatch).
 //      0
 //   9 / \ 1
 //8---+---+---2
@@ -102,37 +460,70 @@ void Star::setRadius(float radius)
 //    |/5\|
 //    6   4
 ///////////////////////////////////////////////////////////////////////////////
-void Star::generatePoints()
+float Star::generateContour(unsigned int pointCount, float radius, Vector2* points,
+                            GenerateMode mode)
+{
+    return generateStrided(pointCount, radius, &points[0].x, &points[0].y, 2, mode);
+}
+
+float Star::generateContour(unsigned int pointCount, float radius, float* x, float* y,
+                            GenerateMode mode)
 {
-    const float PI = 3.141592f / 180.0f;    // step angle in radian
+    return generateStrided(pointCount, radius, x, y, 1, mode);
+}
+
+float Star::generateStrided(unsigned int pointCount, float radius, float* x, float* y,
+                            unsigned int stride, GenerateMode mode)
+{
+    float innerRadius;
+    if(mode == GENERATE_INTERSECT)
+        innerRadius = generateIntersect(pointCount, radius, x, y, stride);
+    else
+        innerRadius = generateClosedForm(pointCount, radius, x, y, stride);
+
+    if(pointCount == 4)
+    {
+        // special case where pointCount=4, use 1/5 of outer radius
+        innerRadius = radius * 0.2f;
+        float side = innerRadius * 0.70710678f;    // on the diagonals
+        x[1*stride] = x[3*stride] = side;
+        y[1*stride] = y[7*stride] = side;
+        x[5*stride] = x[7*stride] = -side;
+        y[3*stride] = y[5*stride] = -side;
+    }
+    return innerRadius;
+}
+
 
-    float angle = 360.0f / pointCount * PI; // angle segment in radian;
-    float x;
-    float y;
+
+///////////////////////////////////////////////////////////////////////////////
+// find each inner point as the intersection of 2 lines passing the outer
+// points, (i-1, i+3) and (i+1, i-3)
+// The angles of outer points are stepped by AngleStepper, not sinf/cosf.
+///////////////////////////////////////////////////////////////////////////////
+float Star::generateIntersect(unsigned int pointCount, float radius, float* x, float* y,
+                              unsigned int stride)
+{
+    AngleStepper angle(0, 2 * AngleStepper::PI / pointCount);   // angle segment
+    float px;
+    float py;
     unsigned i, j, k;
 
     // compute outer points first (even index) ======================
-    for(i = 0; i <= pointCount; i += 2)
+    for(i = 0; i <= pointCount; i += 2, angle.next())
     {
-        j = i / 2;
-        x = radius * sinf(j * angle);
-        y = radius * cosf(j * angle);
+        px = radius * angle.getSin();
+        py = radius * angle.getCos();
 
-        points[i].x = x;
-        points[i].y = y;
-        points3D[i].x = x;
-        points3D[i].y = y;
-        points3D[i].z = 0;
+        x[i*stride] = px;
+        y[i*stride] = py;
 
         // set the point reflected over y-axis
         if(i > 0 && i < pointCount)
         {
             j = 2 * pointCount - i;
-            points[j].x = -x;
-            points[j].y = y;
-            points3D[j].x = -x;
-            points3D[j].y = y;
-            points3D[j].z = 0;
+            x[j*stride] = -px;
+            y[j*stride] = py;
         }
     }
 
@@ -144,42 +535,121 @@ void Star::generatePoints()
         // find line1 with 2 points at i-1 and i+3
         j = i - 1;
         k = i + 3;
-        l1.set(points[k] - points[j], points[j]);
+        l1.set(Vector2(x[k*stride] - x[j*stride], y[k*stride] - y[j*stride]),
+               Vector2(x[j*stride], y[j*stride]));
 
         // find line2 with 2 points at i+1 and i-3
         j = i + 1;
         k = modulo(i - 3, pointCount*2);
-        l2.set(points[k] - points[j], points[j]);
+        l2.set(Vector2(x[k*stride] - x[j*stride], y[k*stride] - y[j*stride]),
+               Vector2(x[j*stride], y[j*stride]));
 
         // find intersection point
         p = l1.intersect(l2);
-        points[i].x = p.x;
-        points[i].y = p.y;
+        x[i*stride] = p.x;
+        y[i*stride] = p.y;
 
         // set the point reflected over y-axis
         if(i < pointCount)
         {
             j = 2 * pointCount - i;
-            points[j].x = -p.x;
-            points[j].y = p.y;
-            points3D[j].x = -p.x;
-            points3D[j].y = p.y;
-            points3D[j].z = 0;
+            x[j*stride] = -p.x;
+            y[j*stride] = p.y;
         }
     }
 
     // compute radius for inner points
-    innerRadius = points[1].length();
-    if(pointCount == 4)
+    return sqrtf(x[stride] * x[stride] + y[stride] * y[stride]);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// compute the inner points without line intersection
+// The line from the outer point j to j+2 is the side of a N-gon, so its
+// distance from the centre is R*cos(a) where a=360/N. The inner point lies on
+// this line and on the bisector of outer j and j+1, therefore;
+//   innerRadius = R * cos(a) / cos(a/2)
+// Each inner point is the outer point rotated by a/2 and scaled by
+// innerRadius/R, so it reuses sin/cos of the outer point.
+// The angles of outer points are stepped by AngleStepper, not sinf/cosf.
+///////////////////////////////////////////////////////////////////////////////
+float Star::generateClosedForm(unsigned int pointCount, float radius, float* x, float* y,
+                               unsigned int stride)
+{
+    double step = 2 * AngleStepper::PI / pointCount;            // angle segment
+    float halfSin = (float)std::sin(step * 0.5);
+    float halfCos = (float)std::cos(step * 0.5);
+    float innerRadius = (float)(radius * std::cos(step) / std::cos(step * 0.5));
+    AngleStepper angle(0, step);
+
+    float s, c;             // sin/cos of outer point
+    float px, py;
+    unsigned i, j;
+    unsigned int count = 2 * pointCount;
+    for(i = 0; i <= pointCount; i += 2, angle.next())
     {
-        // special case where pointCount=4, use 1/5 of outer radius
-        innerRadius = radius * 0.2f;
-        float side = sqrtf(innerRadius * 0.5f);
-        points3D[1].x = points3D[3].x = points[1].x = points[3].x = side;
-        points3D[1].y = points3D[7].y = points[1].y = points[7].y = side;
-        points3D[5].x = points3D[7].x = points[5].x = points[7].x = -side;
-        points3D[3].y = points3D[5].y = points[3].y = points[5].y = -side;
+        // outer point (even index)
+        s = angle.getSin();
+        c = angle.getCos();
+        px = radius * s;
+        py = radius * c;
+        x[i*stride] = px;
+        y[i*stride] = py;
+        if(i > 0 && i < pointCount)
+        {
+            j = count - i;
+            x[j*stride] = -px;
+            y[j*stride] = py;
+        }
+
+        // next inner point (odd index), rotated by angle/2
+        if(i + 1 > pointCount)
+            break;
+        px = innerRadius * (s * halfCos + c * halfSin);
+        py = innerRadius * (c * halfCos - s * halfSin);
+        x[(i+1)*stride] = px;
+        y[(i+1)*stride] = py;
+        if(i + 1 < pointCount)
+        {
+            j = count - i - 1;
+            x[j*stride] = -px;
+            y[j*stride] = py;
+        }
     }
+
+    return innerRadius;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// move the inner points (odd index) of a contour with 2*N points onto the
+// circle with given radius, using SIMD kernels if available
+///////////////////////////////////////////////////////////////////////////////
+void Star::scaleInnerPoints(unsigned int pointCount, float radius, Vector2* points)
+{
+    scaleOddPoints(&points[0].x, 2 * pointCount, radius);
+}
+
+void Star::scaleInnerPoints(unsigned int pointCount, float radius, float* x, float* y)
+{
+    scaleOddPoints(x, y, 2 * pointCount, radius);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// select the method to compute inner points
+///////////////////////////////////////////////////////////////////////////////
+void Star::setGenerateMode(GenerateMode mode)
+{
+    if(this->mode == mode)
+        return;
+
+    this->mode = mode;
+    dirty |= DIRTY_POINT_COUNT;
+    updatePoints();
 }
 
 
@@ -193,12 +663,8 @@ void Star::setInnerRadius(float radius)
         return;
 
     innerRadius = radius;
-    unsigned int count = 2 * pointCount;
-    for(unsigned int i = 1; i < count; i += 2)
-    {
-        points[i] = radius * points[i].normalize();
-        points3D[i] = radius * points3D[i].normalize();
-    }
+    dirty |= DIRTY_INNER_RADIUS;
+    updatePoints();
 }
 
 
@@ -206,29 +672,198 @@ void Star::setInnerRadius(float radius)
 ///////////////////////////////////////////////////////////////////////////////
 // getters
 ///////////////////////////////////////////////////////////////////////////////
+const std::vector<Vector2>& Star::getPoints() const
+{
+    if(!pointsValid)
+    {
+        // build AoS view from SoA, or copy the external AoS storage
+        unsigned int count = 2 * pointCount;
+        trackHeap();
+        points.resize(count);
+        if(layout == LAYOUT_AOS)
+        {
+            std::copy(externalPoints, externalPoints + count, points.begin());
+        }
+        else
+        {
+            const float* x = getSoaStorageX();
+            const float* y = getSoaStorageY();
+            for(unsigned int i = 0; i < count; ++i)
+            {
+                points[i].x = x[i];
+                points[i].y = y[i];
+            }
+        }
+        pointsValid = true;
+    }
+    return points;
+}
+
+const Vector2* Star::getPointData() const
+{
+    if(layout == LAYOUT_AOS)
+        return getAosStorage();
+    return &getPoints()[0];
+}
+
+const std::vector<Vector3>& Star::getPoints3D() const
+{
+    if(!points3DValid)
+    {
+        const float* x = getPointsX();
+        const float* y = getPointsY();
+        unsigned int count = 2 * pointCount;
+        trackHeap();
+        points3D.resize(count);
+        for(unsigned int i = 0; i < count; ++i)
+        {
+            points3D[i].x = x[i];
+            points3D[i].y = y[i];
+            points3D[i].z = 0;
+        }
+        points3DValid = true;
+    }
+    return points3D;
+}
+
+const float* Star::getPointsX() const
+{
+    if(layout == LAYOUT_SOA)
+        return getSoaStorageX();
+
+    if(!pointsSoaValid)
+    {
+        // build SoA view from AoS
+        unsigned int count = 2 * pointCount;
+        const Vector2* src = getAosStorage();
+        trackHeap();
+        pointsX.resize(count);
+        pointsY.resize(count);
+        for(unsigned int i = 0; i < count; ++i)
+        {
+            pointsX[i] = src[i].x;
+            pointsY[i] = src[i].y;
+        }
+        pointsSoaValid = true;
+    }
+    return pointsX.get();
+}
+
+const float* Star::getPointsY() const
+{
+    if(layout == LAYOUT_SOA)
+        return getSoaStorageY();
+
+    getPointsX();
+    return pointsY.get();
+}
+
 const Vector2& Star::getPoint(int index) const
 {
-    return points.at(index);
+    if(index < 0 || index >= 2 * (int)pointCount)
+        throw std::out_of_range("Star::getPoint");
+    return getPointData()[index];
 }
 
 const Vector3& Star::getPoint3D(int index) const
 {
-    return points3D.at(index);
+    return getPoints3D().at(index);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return the indices of the mesh, rebuild them if the point count is changed
+///////////////////////////////////////////////////////////////////////////////
+const std::vector<unsigned int>& Star::getFillIndices() const
+{
+    if(indexPointCount != pointCount)
+        buildIndices();
+    return fillIndices;
+}
+
+const std::vector<unsigned int>& Star::getEdgeIndices() const
+{
+    if(indexPointCount != pointCount)
+        buildIndices();
+    return edgeIndices;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// build the indices of the triangles and the line loop for 2*N points
+// The order is fixed for the point count, and all triangles are CCW;
+// - N spikes: (inner i, outer i-1, inner i-2), i = 2N-1, 2N-3, ..., 1
+// - N-2 triangles of inner N-gon as a fan from the inner point 2N-1
+///////////////////////////////////////////////////////////////////////////////
+void Star::buildIndices() const
+{
+    int count = 2 * (int)pointCount;
+    int i, k;
+
+    trackHeap();
+    fillIndices.resize(3 * (count - 2));
+    unsigned int* index = &fillIndices[0];
+    for(i = count - 1; i > 0; i -= 2)
+    {
+        k = (i >= 2) ? i - 2 : count - 1;
+        *index++ = i;
+        *index++ = i - 1;
+        *index++ = k;
+    }
+    for(i = count - 3; i > 1; i -= 2)
+    {
+        *index++ = count - 1;
+        *index++ = i;
+        *index++ = i - 2;
+    }
+
+    edgeIndices.resize(count);
+    for(i = 0; i < count; ++i)
+        edgeIndices[i] = i;
+
+    indexPointCount = pointCount;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// a star of the arena allocates a view on the heap, so it must be destroyed
+// by StarArena::reset()
+///////////////////////////////////////////////////////////////////////////////
+void Star::trackHeap() const
+{
+    if(arena && !tracked)
+    {
+        arena->track(const_cast<Star*>(this));
+        tracked = true;
+    }
 }
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
 // round all point values to the nearest int
+// Both AoS and SoA are contiguous floats, so it is a single pass over them.
 ///////////////////////////////////////////////////////////////////////////////
 void Star::roundInt()
 {
+    if(pointCount == 0)
+        return;
+
     unsigned int count = 2 * pointCount;
-    for(unsigned int i = 0; i < count; ++i)
+    if(layout == LAYOUT_AOS)
+    {
+        roundPoints(&getAosStorage()->x, 2 * count);
+    }
+    else
     {
-        points3D[i].x = points[i].x = (float)round(points[i].x);
-        points3D[i].y = points[i].y = (float)round(points[i].y);
+        roundPoints(getSoaStorageX(), count);
+        roundPoints(getSoaStorageY(), count);
     }
+    invalidateViews();
+    ++version;
 }
 
 
@@ -238,6 +873,7 @@ void Star::roundInt()
 ///////////////////////////////////////////////////////////////////////////////
 void Star::printSelf()
 {
+    const std::vector<Vector2>& points = getPoints();
 
     std::cout << "Star\n"
               << "====\n";
@@ -7,26 +7,90 @@
 // Star object can be created with given radius. Then, the top point will be
 // (0, radius).
 //
-// Dependencies: Vector2, Vector3
+// The points are stored either as an array of Vector2 (LAYOUT_AOS, default),
+// or as separate x[] and y[] arrays aligned at 32-byte (LAYOUT_SOA). The other
+// layout and the 3D points are built on demand when the getters are called.
+//
+// The setters mark the changed fields dirty, and only the minimal update is
+// done; the contour of radius=1 is shared from StarContourCache, so changing
+// the radius is a scale of it, and the same point count is not generated
+// again by any star.
+//
+// The indexed mesh for rendering (triangles for fill and line loop for
+// edges) is built on demand once per point count, in stable order, so a
+// renderer can upload it once and check the version counters for changes.
+//
+// The points are on the heap by default. A star can be built into a buffer
+// of the caller (AoS only), or into StarArena with StarArena::createStar(),
+// then the storage of the points is not allocated by Star. If the point count
+// grows over the buffer of the caller, the points are moved to the heap. A
+// copy of the star always owns its points. getPointView() reads the points of
+// any storage without copying them into std::vector.
+//
+// Dependencies: Vector2, Vector3, AlignedArray, pointKernels, StarContourCache
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2016-01-13
-// UPDATED: 2016-03-14
+// UPDATED: 2026-10-18
 ///////////////////////////////////////////////////////////////////////////////
 
 #ifndef STAR_H_DEF
 #define STAR_H_DEF
 
+#include <memory>
 #include <vector>
 #include "Vectors.h"
+#include "AlignedArray.h"
+
+struct StarContour;
+class StarArena;
 
 class Star
 {
 public:
+    // methods to compute the inner points
+    enum GenerateMode
+    {
+        GENERATE_INTERSECT = 0,     // intersect 2 lines through the outer points
+        GENERATE_CLOSED_FORM        // inner radius from N-gon, then rotate outer points
+    };
+
+    // memory layout of the points
+    enum Layout
+    {
+        LAYOUT_AOS = 0,             // std::vector<Vector2>
+        LAYOUT_SOA                  // 32-byte aligned x[] and y[]
+    };
+
+    // non-owning view of the AoS points, valid until the star is changed
+    class PointView
+    {
+    public:
+        PointView() : points(0), count(0) {}
+        PointView(const Vector2* points, unsigned int count) : points(points), count(count) {}
+
+        const Vector2* data() const                         { return points; }
+        unsigned int size() const                           { return count; }
+        bool empty() const                                  { return count == 0; }
+        const Vector2* begin() const                        { return points; }
+        const Vector2* end() const                          { return points + count; }
+        const Vector2& operator[](unsigned int index) const { return points[index]; }
+
+    private:
+        const Vector2* points;
+        unsigned int count;
+    };
+
     // ctor/dtor
-    Star(unsigned int pointCount=5, float radius=1);
+    Star(unsigned int pointCount=5, float radius=1, Layout layout=LAYOUT_AOS);
+    Star(Vector2* buffer, unsigned int capacity, unsigned int pointCount=5, float radius=1); // capacity >= 2N
+    Star(const Star& rhs);
+    Star(Star&& rhs) noexcept;
     ~Star();
 
+    Star& operator=(const Star& rhs);
+    Star& operator=(Star&& rhs) noexcept;   // copies if either star uses an arena or a buffer
+
     // setters/getters
     void set(unsigned int count, float radius);
 
@@ -39,31 +103,123 @@ public:
     void setInnerRadius(float radius=1);        // generate new star with radius
     float getInnerRadius() const { return innerRadius; }
 
-    const std::vector<Vector2>& getPoints() const { return points; }
-    const std::vector<Vector3>& getPrints3D() const;
+    void setGenerateMode(GenerateMode mode);    // re-generate if mode is changed
+    GenerateMode getGenerateMode() const { return mode; }
+
+    void setLayout(Layout layout);              // convert the storage of points
+    Layout getLayout() const { return layout; }
+
+    // AoS view, built on demand if the layout is LAYOUT_SOA
+    const std::vector<Vector2>& getPoints() const;
+    const std::vector<Vector3>& getPoints3D() const;    // always built on demand
+
+    // SoA view (2*N elements), built on demand if the layout is LAYOUT_AOS
+    const float* getPointsX() const;
+    const float* getPointsY() const;
+
+    // AoS points (2*N elements) without std::vector, built on demand if SoA
+    const Vector2* getPointData() const;
+    PointView getPointView() const              { return PointView(getPointData(), 2 * pointCount); }
 
     const Vector2& getPoint(int index) const;   // return a single point corresponding index
     const Vector3& getPoint3D(int index) const;
 
+    // indices to getPoints(), built on demand if the point count is changed
+    // fill: N spikes (inner, outer, next inner), then fan of inner N-gon
+    const std::vector<unsigned int>& getFillIndices() const;    // GL_TRIANGLES, 3*(2N-2)
+    const std::vector<unsigned int>& getEdgeIndices() const;    // GL_LINE_LOOP, 2N
+
+    // increased when the points are changed, or the point count (indices) is changed
+    unsigned int getVersion() const             { return version; }
+    unsigned int getIndexVersion() const        { return indexVersion; }
+
     // round the coordinates to the nearest integer
     void roundInt();
 
     // debug
     void printSelf();
 
+    // generate a contour of 2*N points into the given buffer without Star object
+    // It returns the radius of the inner points.
+    static float generateContour(unsigned int pointCount, float radius, Vector2* points,
+                                 GenerateMode mode=GENERATE_CLOSED_FORM);
+    static float generateContour(unsigned int pointCount, float radius, float* x, float* y,
+                                 GenerateMode mode=GENERATE_CLOSED_FORM);
+    static void scaleInnerPoints(unsigned int pointCount, float radius, Vector2* points);
+    static void scaleInnerPoints(unsigned int pointCount, float radius, float* x, float* y);
+
 protected:
 
 private:
-    // re-generate outer/inner points
-    void generatePoints();
+    friend class StarArena;
+
+    // changed fields since the last update
+    enum
+    {
+        DIRTY_POINT_COUNT   = 0x1,      // also for generate mode
+        DIRTY_RADIUS        = 0x2,
+        DIRTY_INNER_RADIUS  = 0x4
+    };
+
+    // ctor for StarArena::createStar()
+    Star(StarArena* arena, unsigned int pointCount, float radius, Layout layout);
+
+    // storage of current layout, in external memory or owned
+    Vector2* getAosStorage() const      { return externalPoints ? externalPoints : points.data(); }
+    float* getSoaStorageX() const       { return externalX ? externalX : pointsX.get(); }
+    float* getSoaStorageY() const       { return externalY ? externalY : pointsY.get(); }
+
+    // re-generate outer/inner points for the dirty fields
+    void updatePoints();
+    void resizePoints();                        // resize the storage of current layout
+    void invalidateViews();                     // views on demand must be rebuilt
+    void buildIndices() const;                  // fill and edge indices for pointCount
+    void trackHeap() const;                     // the star of arena uses the heap
+
+    // contour generators on strided x/y (stride=2 for Vector2, 1 for SoA)
+    static float generateStrided(unsigned int pointCount, float radius, float* x, float* y,
+                                 unsigned int stride, GenerateMode mode);
+    static float generateIntersect(unsigned int pointCount, float radius, float* x, float* y, unsigned int stride);
+    static float generateClosedForm(unsigned int pointCount, float radius, float* x, float* y, unsigned int stride);
 
     // compute modular arithmetic (It always returns unsigned int)
-    unsigned int modulo(int dividend, int divisor);
+    static unsigned int modulo(int dividend, int divisor);
 
     unsigned int pointCount;
     float radius;                   // for outer points
     float innerRadius;              // for inner points
-    std::vector<Vector2> points;    // 2*N points to make star contour
-    std::vector<Vector3> points3D;  // as 3D
+    GenerateMode mode;
+    Layout layout;
+    unsigned int dirty;                     // DIRTY_* flags
+
+    // contour with radius=1 for the current point count and mode
+    // It is owned by unitContour, or pinned by the arena.
+    std::shared_ptr<const StarContour> unitContour;
+    const StarContour* contour;
+
+    // storage of current layout not owned by Star (caller's buffer or arena)
+    // instead of points (AoS) or pointsX/pointsY (SoA)
+    Vector2* externalPoints;
+    float* externalX;
+    float* externalY;
+    unsigned int externalCapacity;          // # of points
+    StarArena* arena;                       // 0 if not in arena
+    mutable bool tracked;                   // destroyed by StarArena::reset()
+
+    // the storage of current layout is always valid, the others are views
+    mutable std::vector<Vector2> points;    // 2*N points to make star contour
+    mutable AlignedArray pointsX;           // as SoA
+    mutable AlignedArray pointsY;
+    mutable std::vector<Vector3> points3D;  // as 3D
+    mutable bool pointsValid;               // AoS view is up to date
+    mutable bool pointsSoaValid;            // SoA view is up to date
+    mutable bool points3DValid;
+
+    // indexed mesh
+    mutable std::vector<unsigned int> fillIndices;
+    mutable std::vector<unsigned int> edgeIndices;
+    mutable unsigned int indexPointCount;   // point count of the indices, 0 if not built
+    unsigned int version;
+    unsigned int indexVersion;
 };
 #endif
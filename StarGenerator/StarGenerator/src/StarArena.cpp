@@ -0,0 +1,238 @@
+///////////////////////////////////////////////////////////////////////////////
+// StarArena.cpp
+// =============
+// bump allocator for short-lived Star objects and their points
+// The memory is a list of blocks. An allocation bumps the offset of current
+// block, and moves to the next block if it does not fit. reset() rewinds to
+// the first block, so the blocks grown in the first frame are reused by the
+// next frames without calling the heap allocator.
+//
+// Dependencies: Star, StarContourCache
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#ifdef _WIN32
+#include <malloc.h>     // for _aligned_malloc()
+#endif
+#include "StarArena.h"
+#include "StarContourCache.h"
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor/dtor
+///////////////////////////////////////////////////////////////////////////////
+StarArena::StarArena(std::size_t blockSize) : blockSize(blockSize), blockIndex(0), offset(0),
+                                              usedSize(0), starCount(0)
+{
+}
+
+StarArena::~StarArena()
+{
+    release();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// construct a star in the arena memory
+///////////////////////////////////////////////////////////////////////////////
+Star* StarArena::createStar(unsigned int pointCount, float radius, Star::Layout layout)
+{
+    void* memory = allocate(sizeof(Star), alignof(Star));
+    Star* star = new(memory) Star(this, pointCount, radius, layout);
+    ++starCount;
+    return star;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// bump the offset of current block, the alignment must be power of 2
+///////////////////////////////////////////////////////////////////////////////
+void* StarArena::allocate(std::size_t size, std::size_t alignment)
+{
+    std::size_t start = (offset + alignment - 1) & ~(alignment - 1);
+    if(blockIndex >= blocks.size() || start + size > blocks[blockIndex].size)
+    {
+        nextBlock(size + alignment);
+        start = (offset + alignment - 1) & ~(alignment - 1);
+    }
+
+    // blocks are 32-byte aligned, so aligning the offset aligns the address
+    offset = start + size;
+    return blocks[blockIndex].data + start;
+}
+
+Vector2* StarArena::allocatePoints(unsigned int count)
+{
+    return (Vector2*)allocate(count * sizeof(Vector2));
+}
+
+float* StarArena::allocateFloats(unsigned int count)
+{
+    unsigned int capacity = (count + 7) / 8 * 8;
+    float* values = (float*)allocate(capacity * sizeof(float));
+    if(capacity > count)
+        std::memset(values + count, 0, (capacity - count) * sizeof(float));
+    return values;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// the next block that can hold the size, the smaller blocks are skipped
+// If none, add a new block of max(blockSize, size).
+///////////////////////////////////////////////////////////////////////////////
+void StarArena::nextBlock(std::size_t size)
+{
+    if(blockIndex < blocks.size())
+    {
+        usedSize += offset;
+        ++blockIndex;
+    }
+    offset = 0;
+
+    while(blockIndex < blocks.size() && blocks[blockIndex].size < size)
+        ++blockIndex;
+
+    if(blockIndex == blocks.size())
+    {
+        Block block;
+        block.size = (size > blockSize) ? size : blockSize;
+        void* data;
+#ifdef _WIN32
+        data = _aligned_malloc(block.size, ALIGNMENT);
+#else
+        if(posix_memalign(&data, ALIGNMENT, block.size) != 0)
+            data = 0;
+#endif
+        if(!data)
+            throw std::bad_alloc();
+        block.data = (char*)data;
+        blocks.push_back(block);
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// free all stars and memory of the arena in O(1)
+// Only the stars having heap memory are destroyed, and the contours pinned in
+// this frame are released.
+///////////////////////////////////////////////////////////////////////////////
+void StarArena::reset()
+{
+    for(std::size_t i = 0; i < trackedStars.size(); ++i)
+        trackedStars[i]->~Star();
+    trackedStars.clear();
+    contours.clear();
+    if(!pinSlots.empty())
+        std::memset(&pinSlots[0], 0, pinSlots.size() * sizeof(pinSlots[0]));
+
+    blockIndex = 0;
+    offset = 0;
+    usedSize = 0;
+    starCount = 0;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// reset() and free the blocks
+///////////////////////////////////////////////////////////////////////////////
+void StarArena::release()
+{
+    reset();
+    for(std::size_t i = 0; i < blocks.size(); ++i)
+    {
+#ifdef _WIN32
+        _aligned_free(blocks[i].data);
+#else
+        std::free(blocks[i].data);
+#endif
+    }
+    blocks.clear();
+    std::vector<const StarContour*>().swap(pinSlots);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// getters
+///////////////////////////////////////////////////////////////////////////////
+std::size_t StarArena::getUsedSize() const
+{
+    return usedSize + offset;
+}
+
+std::size_t StarArena::getCapacity() const
+{
+    std::size_t size = 0;
+    for(std::size_t i = 0; i < blocks.size(); ++i)
+        size += blocks[i].size;
+    return size;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// keep a shared contour until reset()
+// The pinned contours are found by their address in an open addressing table
+// (linear probing), which is kept at most half full. The table keeps its size
+// over reset(), so pinning does not allocate in the next frames.
+///////////////////////////////////////////////////////////////////////////////
+void StarArena::pin(const std::shared_ptr<const StarContour>& contour)
+{
+    const StarContour* key = contour.get();
+    if(2 * (contours.size() + 1) > pinSlots.size())
+        growPinSlots();
+
+    std::size_t mask = pinSlots.size() - 1;
+    std::size_t i = hashPin(key) & mask;
+    while(pinSlots[i])
+    {
+        if(pinSlots[i] == key)
+            return;
+        i = (i + 1) & mask;
+    }
+    pinSlots[i] = key;
+    contours.push_back(contour);
+}
+
+void StarArena::growPinSlots()
+{
+    std::size_t size = pinSlots.empty() ? (std::size_t)MIN_PIN_SLOTS : pinSlots.size() * 2;
+    pinSlots.assign(size, 0);
+
+    std::size_t mask = size - 1;
+    for(std::size_t j = 0; j < contours.size(); ++j)
+    {
+        std::size_t i = hashPin(contours[j].get()) & mask;
+        while(pinSlots[i])
+            i = (i + 1) & mask;
+        pinSlots[i] = contours[j].get();
+    }
+}
+
+// the low bits of an address are 0 by alignment, mix the high bits into them
+std::size_t StarArena::hashPin(const StarContour* contour)
+{
+    std::size_t h = (std::size_t)contour;
+    return (h >> 4) ^ (h >> 12);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// register the star to destroy by reset()
+///////////////////////////////////////////////////////////////////////////////
+void StarArena::track(Star* star)
+{
+    trackedStars.push_back(star);
+}
@@ -0,0 +1,99 @@
+///////////////////////////////////////////////////////////////////////////////
+// StarArena.h
+// ===========
+// bump allocator for short-lived Star objects and their points
+// createStar() places a Star and its 2*N points in the blocks of the arena,
+// so building a star does not call the heap allocator once the blocks are
+// grown. reset() frees all stars and points of the arena at once in O(1);
+// the blocks are kept for the next frame.
+//
+// The stars of the arena must not be deleted, and they are invalid after
+// reset(). Their contours are pinned by the arena until reset(), so the
+// stars do not need destructors. Only if a star builds a view on the heap
+// (getPoints() of a SoA star, getPoints3D(), the indices, ...), it is
+// destroyed by reset(), which is O(# of those stars).
+//
+// StarArena is not thread-safe, use an arena per thread.
+//
+// Dependencies: Star, StarContourCache
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef STAR_ARENA_H_DEF
+#define STAR_ARENA_H_DEF
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "Star.h"
+
+struct StarContour;
+
+class StarArena
+{
+public:
+    enum { ALIGNMENT = 32, DEFAULT_BLOCK_SIZE = 1 << 20, MIN_PIN_SLOTS = 16 };
+
+    // ctor/dtor
+    explicit StarArena(std::size_t blockSize=DEFAULT_BLOCK_SIZE);
+    ~StarArena();
+
+    // build a star in the arena, it is valid until reset()
+    Star* createStar(unsigned int pointCount=5, float radius=1, Star::Layout layout=Star::LAYOUT_AOS);
+
+    // raw memory aligned at 32-byte, valid until reset()
+    void* allocate(std::size_t size, std::size_t alignment=ALIGNMENT);
+    Vector2* allocatePoints(unsigned int count);
+    float* allocateFloats(unsigned int count);  // padded to 8 floats with 0
+
+    // free all stars and memory, the blocks are kept
+    void reset();
+
+    // reset() and return the blocks to the heap
+    void release();
+
+    std::size_t getUsedSize() const;            // bytes allocated since reset()
+    std::size_t getCapacity() const;            // bytes of all blocks
+    unsigned int getStarCount() const           { return starCount; }
+    unsigned int getBlockCount() const          { return (unsigned int)blocks.size(); }
+
+protected:
+
+private:
+    friend class Star;
+
+    struct Block
+    {
+        char* data;
+        std::size_t size;
+    };
+
+    // keep the contour alive until reset()
+    void pin(const std::shared_ptr<const StarContour>& contour);
+    void growPinSlots();
+    static std::size_t hashPin(const StarContour* contour);
+
+    // the star has memory on the heap, so destroy it by reset()
+    void track(Star* star);
+
+    // move to the next block that has the size, or add a new block
+    void nextBlock(std::size_t size);
+
+    // no copy
+    StarArena(const StarArena&);
+    StarArena& operator=(const StarArena&);
+
+    std::vector<Block> blocks;
+    std::size_t blockSize;                      // default size of a new block
+    std::size_t blockIndex;                     // current block
+    std::size_t offset;                         // next free byte of current block
+    std::size_t usedSize;                       // bytes of the previous blocks
+    unsigned int starCount;
+    std::vector<std::shared_ptr<const StarContour> > contours;     // pinned until reset()
+    std::vector<const StarContour*> pinSlots;   // hash table of pinned contours, size is power of 2
+    std::vector<Star*> trackedStars;
+};
+
+#endif
@@ -0,0 +1,271 @@
+///////////////////////////////////////////////////////////////////////////////
+// StarBatch.cpp
+// =============
+// class to generate the contours of many N-pointed stars at once.
+// The input is the arrays of the # of outer points, outer radius and inner
+// radius for each star. All contours are written into one contiguous buffer,
+// and the offset table tells where each contour begins:
+// the points of i-th star are points[offsets[i]] ... points[offsets[i+1]-1].
+//
+// The output buffer is allocated once per generate() call (and reused if the
+// capacity is enough), so there is no per-star allocation. It is not
+// initialized; each star writes all of its points, so the pages of a new
+// buffer are touched first by the workers of generateParallel().
+// generateParallel() splits the stars into the workers of WorkPool, and can
+// place each star at the given position.
+//
+// Dependencies: Vector2, Star, StarContourCache, pointKernels, WorkPool
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+#include "StarBatch.h"
+#include "StarContourCache.h"
+#include "pointKernels.h"
+
+// constants
+const unsigned int OFFSET_BLOCK = 65536;    // # of stars per block for prefix sum
+const unsigned int GENERATE_GRAIN = 1024;   // # of stars per chunk of a worker
+const unsigned int UNIT_MEMO_SIZE = 16;     // # of unit contours remembered per chunk
+const unsigned long long MAX_POINT_COUNT = (std::size_t)-1 / sizeof(Vector2);
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// # of points of the stars in [begin, end), in 64 bits to detect the total
+// that does not fit in size_t of 32-bit build
+///////////////////////////////////////////////////////////////////////////////
+static unsigned long long sumPointCounts(const unsigned int* pointCounts, unsigned int begin,
+                                         unsigned int end)
+{
+    unsigned long long sum = 0;
+    for(unsigned int i = begin; i < end; ++i)
+        sum += 2 * (unsigned long long)(pointCounts[i] < 4 ? 4 : pointCounts[i]);
+    return sum;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor
+///////////////////////////////////////////////////////////////////////////////
+StarBatch::StarBatch() : starCount(0), points(0), pointCapacity(0), offsets(1, 0),
+                         mode(Star::GENERATE_CLOSED_FORM)
+{
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// dtor
+///////////////////////////////////////////////////////////////////////////////
+StarBatch::~StarBatch()
+{
+    std::free(points);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// generate the contours of all stars
+// It throws std::length_error if the total # of points does not fit in memory.
+// 1. count the points, and allocate the output buffer only once
+// 2. compute the offset of each contour
+// 3. scale the cached unit contour into place for each star
+///////////////////////////////////////////////////////////////////////////////
+void StarBatch::generate(const unsigned int* pointCounts, const float* radii,
+                         const float* innerRadii, unsigned int starCount)
+{
+    unsigned long long total = sumPointCounts(pointCounts, 0, starCount);
+    if(total > MAX_POINT_COUNT)
+        throw std::length_error("StarBatch::generate");
+    reservePoints((std::size_t)total);
+
+    this->starCount = starCount;
+    offsets.resize(starCount + 1);
+    this->innerRadii.resize(starCount);
+
+    offsets[starCount] = computeOffsets(pointCounts, 0, starCount, 0);
+    generateRange(radii, innerRadii, 0, 0, starCount);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// generate the contours of all stars with multiple threads
+// Same steps as generate(), but the stars are split into blocks, and the
+// blocks are processed by the workers of the pool. The prefix sum of offsets
+// is done in 2 passes; the sum of each block, then the offsets of each block
+// starting from the sum of previous blocks.
+// Each star writes its own range of the buffers, so no lock is required.
+///////////////////////////////////////////////////////////////////////////////
+void StarBatch::generateParallel(const unsigned int* pointCounts, const float* radii,
+                                 const float* innerRadii, const Vector2* positions,
+                                 unsigned int starCount, WorkPool* pool)
+{
+    if(!pool)
+        pool = &WorkPool::getInstance();
+
+    // pass 1: sum of each block
+    unsigned int blockCount = (starCount + OFFSET_BLOCK - 1) / OFFSET_BLOCK;
+    std::vector<unsigned long long> blockOffsets(blockCount + 1, 0);
+    pool->parallelFor(blockCount, 1, [&](unsigned int begin, unsigned int end)
+    {
+        for(unsigned int b = begin; b < end; ++b)
+        {
+            unsigned int last = (b + 1) * OFFSET_BLOCK < starCount ? (b + 1) * OFFSET_BLOCK : starCount;
+            blockOffsets[b + 1] = sumPointCounts(pointCounts, b * OFFSET_BLOCK, last);
+        }
+    });
+    for(unsigned int b = 0; b < blockCount; ++b)
+        blockOffsets[b + 1] += blockOffsets[b];
+    if(blockOffsets[blockCount] > MAX_POINT_COUNT)
+        throw std::length_error("StarBatch::generateParallel");
+
+    // not initialized, the workers touch the pages of their stars first
+    reservePoints((std::size_t)blockOffsets[blockCount]);
+
+    this->starCount = starCount;
+    offsets.resize(starCount + 1);
+    this->innerRadii.resize(starCount);
+
+    // pass 2: offsets of each star
+    pool->parallelFor(blockCount, 1, [&](unsigned int begin, unsigned int end)
+    {
+        for(unsigned int b = begin; b < end; ++b)
+        {
+            unsigned int last = (b + 1) * OFFSET_BLOCK < starCount ? (b + 1) * OFFSET_BLOCK : starCount;
+            computeOffsets(pointCounts, b * OFFSET_BLOCK, last, (std::size_t)blockOffsets[b]);
+        }
+    });
+    offsets[starCount] = (std::size_t)blockOffsets[blockCount];
+
+    pool->parallelFor(starCount, GENERATE_GRAIN, [&](unsigned int begin, unsigned int end)
+    {
+        generateRange(radii, innerRadii, positions, begin, end);
+    });
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// fill offsets[begin] ... offsets[end-1] starting from offset
+// It returns the offset after the last star.
+///////////////////////////////////////////////////////////////////////////////
+std::size_t StarBatch::computeOffsets(const unsigned int* pointCounts, unsigned int begin,
+                                      unsigned int end, std::size_t offset)
+{
+    for(unsigned int i = begin; i < end; ++i)
+    {
+        offsets[i] = offset;
+        unsigned int count = pointCounts[i] < 4 ? 4 : pointCounts[i];
+        offset += 2 * (std::size_t)count;
+    }
+    return offset;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// allocate the buffer for count points if the capacity is not enough
+// malloc() does not touch the memory, and the old contours are not kept.
+// If it fails, the batch becomes empty and std::bad_alloc is thrown.
+///////////////////////////////////////////////////////////////////////////////
+void StarBatch::reservePoints(std::size_t count)
+{
+    if(count <= pointCapacity)
+        return;
+
+    clear();
+    points = (Vector2*)std::malloc(count * sizeof(Vector2));
+    if(!points)
+        throw std::bad_alloc();
+    pointCapacity = count;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// generate the contours of the stars in [begin, end)
+// The unit contours are remembered by the point count for this range, so the
+// cache is not locked for each star.
+// If the inner radius is overridden, the inner points are moved before
+// translating the contour, because scaleInnerPoints() is about the origin.
+///////////////////////////////////////////////////////////////////////////////
+void StarBatch::generateRange(const float* radii, const float* innerRadii, const Vector2* positions,
+                              unsigned int begin, unsigned int end)
+{
+    StarContourCache& cache = StarContourCache::getInstance();
+    StarContourCache::ContourPtr units[UNIT_MEMO_SIZE];
+
+    for(unsigned int i = begin; i < end; ++i)
+    {
+        unsigned int count = (unsigned int)((offsets[i+1] - offsets[i]) / 2);
+        float radius = radii[i] < 0 ? 0 : radii[i];
+        Vector2* contour = points + offsets[i];
+
+        StarContourCache::ContourPtr& unit = units[count % UNIT_MEMO_SIZE];
+        if(!unit || unit->pointCount != count)
+            unit = cache.get(count, mode);
+
+        float innerRadius = unit->innerRadius * radius;
+        if(innerRadii && innerRadii[i] >= 0)
+        {
+            innerRadius = innerRadii[i];
+            scalePoints(&unit->points[0].x, &contour->x, 4 * count, radius);
+            Star::scaleInnerPoints(count, innerRadius, contour);
+            if(positions)
+                transformPoints(&contour->x, &contour->x, 2 * count, 1.0f, positions[i].x, positions[i].y);
+        }
+        else if(positions)
+        {
+            transformPoints(&unit->points[0].x, &contour->x, 2 * count, radius, positions[i].x, positions[i].y);
+        }
+        else
+        {
+            scalePoints(&unit->points[0].x, &contour->x, 4 * count, radius);
+        }
+        this->innerRadii[i] = innerRadius;
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// getters
+///////////////////////////////////////////////////////////////////////////////
+const Vector2* StarBatch::getStarPoints(unsigned int index) const
+{
+    if(index >= starCount)
+        throw std::out_of_range("StarBatch::getStarPoints");
+    return points + offsets[index];
+}
+
+unsigned int StarBatch::getStarPointCount(unsigned int index) const
+{
+    return (unsigned int)((offsets.at(index + 1) - offsets.at(index)) / 2);
+}
+
+float StarBatch::getStarInnerRadius(unsigned int index) const
+{
+    return innerRadii.at(index);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// release all contours
+///////////////////////////////////////////////////////////////////////////////
+void StarBatch::clear()
+{
+    starCount = 0;
+    std::free(points);
+    points = 0;
+    pointCapacity = 0;
+    offsets.assign(1, 0);
+    innerRadii.clear();
+}
@@ -0,0 +1,90 @@
+///////////////////////////////////////////////////////////////////////////////
+// StarBatch.h
+// ===========
+// class to generate the contours of many N-pointed stars at once.
+// The input is the arrays of the # of outer points, outer radius and inner
+// radius for each star. All contours are written into one contiguous buffer,
+// and the offset table tells where each contour begins:
+// the points of i-th star are points[offsets[i]] ... points[offsets[i+1]-1].
+//
+// The output buffer is allocated once per generate() call (and reused if the
+// capacity is enough), so there is no per-star allocation. It is not
+// initialized; each star writes all of its points, so the pages of a new
+// buffer are touched first by the workers of generateParallel().
+// generateParallel() splits the stars into the workers of WorkPool, and can
+// place each star at the given position.
+//
+// The offsets are size_t, so the total # of points can exceed 2^32.
+//
+// Dependencies: Vector2, Star, StarContourCache, pointKernels, WorkPool
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef STAR_BATCH_H_DEF
+#define STAR_BATCH_H_DEF
+
+#include <cstddef>
+#include <vector>
+#include "Vectors.h"
+#include "Star.h"
+#include "WorkPool.h"
+
+class StarBatch
+{
+public:
+    // ctor/dtor
+    StarBatch();
+    ~StarBatch();
+
+    // generate contours of N stars
+    // innerRadii can be NULL, or a negative value for the star, in order to
+    // use the default inner radius of the star
+    void generate(const unsigned int* pointCounts, const float* radii,
+                  const float* innerRadii, unsigned int starCount);
+
+    // same as generate(), but with the threads of the pool (NULL: shared pool)
+    // positions can be NULL, in order to place all stars at the origin
+    void generateParallel(const unsigned int* pointCounts, const float* radii,
+                          const float* innerRadii, const Vector2* positions,
+                          unsigned int starCount, WorkPool* pool=0);
+
+    unsigned int getStarCount() const               { return starCount; }
+    std::size_t getTotalPointCount() const          { return offsets.back(); }
+
+    const Vector2* getPoints() const                { return points; }    // getTotalPointCount() elements
+    const std::vector<std::size_t>& getOffsets() const  { return offsets; }
+
+    // per-star access
+    const Vector2* getStarPoints(unsigned int index) const;
+    unsigned int getStarPointCount(unsigned int index) const;   // # of outer points (N)
+    float getStarInnerRadius(unsigned int index) const;
+
+    void clear();
+
+    // method to compute inner points for the next generate() call
+    void setGenerateMode(Star::GenerateMode mode)   { this->mode = mode; }
+    Star::GenerateMode getGenerateMode() const      { return mode; }
+
+protected:
+
+private:
+    StarBatch(const StarBatch& rhs);                // no implementation
+    StarBatch& operator=(const StarBatch& rhs);
+
+    std::size_t computeOffsets(const unsigned int* pointCounts, unsigned int begin,
+                               unsigned int end, std::size_t offset);
+    void generateRange(const float* radii, const float* innerRadii, const Vector2* positions,
+                       unsigned int begin, unsigned int end);
+    void reservePoints(std::size_t count);          // grow the buffer without initializing it
+
+    unsigned int starCount;
+    Vector2* points;                    // contours of all stars (2*N each), not initialized
+    std::size_t pointCapacity;
+    std::vector<std::size_t> offsets;   // starCount+1 entries, prefix sum of 2*N
+    std::vector<float> innerRadii;      // computed (or overridden) inner radius
+    Star::GenerateMode mode;
+};
+
+#endif
@@ -0,0 +1,155 @@
+///////////////////////////////////////////////////////////////////////////////
+// StarContourCache.cpp
+// ====================
+// process-wide cache of the star contours with radius=1, keyed by the # of
+// outer points and the generate mode. A star with any radius is the scale of
+// the cached contour, so sin/cos and inner points are computed once per
+// point count.
+//
+// Dependencies: Vector2, Star
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include "StarContourCache.h"
+
+// constants
+const unsigned int DEFAULT_CAPACITY = 256;
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor/dtor
+///////////////////////////////////////////////////////////////////////////////
+StarContourCache::StarContourCache() : capacity(DEFAULT_CAPACITY), hitCount(0), missCount(0)
+{
+}
+
+StarContourCache::~StarContourCache()
+{
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// instantiate a singleton instance if not exist
+///////////////////////////////////////////////////////////////////////////////
+StarContourCache& StarContourCache::getInstance()
+{
+    static StarContourCache self;
+    return self;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// find the contour and move it to the front of LRU list
+// If missed, generate it without lock, so other threads are not blocked.
+// If another thread added the same contour meanwhile, use that one.
+///////////////////////////////////////////////////////////////////////////////
+StarContourCache::ContourPtr StarContourCache::get(unsigned int pointCount, Star::GenerateMode mode)
+{
+    if(pointCount < 4)
+        pointCount = 4;     // same as Star
+    unsigned long long key = makeKey(pointCount, mode);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::unordered_map<unsigned long long, ContourList::iterator>::iterator it = lookup.find(key);
+        if(it != lookup.end())
+        {
+            contours.splice(contours.begin(), contours, it->second);
+            ++hitCount;
+            return contours.front();
+        }
+    }
+    ++missCount;
+
+    std::shared_ptr<StarContour> contour = std::make_shared<StarContour>();
+    contour->pointCount = pointCount;
+    contour->mode = mode;
+    contour->points.resize(2 * pointCount);
+    contour->innerRadius = Star::generateContour(pointCount, 1.0f, &contour->points[0], mode);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unordered_map<unsigned long long, ContourList::iterator>::iterator it = lookup.find(key);
+    if(it != lookup.end())
+    {
+        contours.splice(contours.begin(), contours, it->second);
+        return contours.front();
+    }
+    contours.push_front(contour);
+    lookup[key] = contours.begin();
+    evict();
+    return contour;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// set the max # of contours
+///////////////////////////////////////////////////////////////////////////////
+void StarContourCache::setCapacity(unsigned int count)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    capacity = count < 1 ? 1 : count;
+    evict();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return # of cached contours
+///////////////////////////////////////////////////////////////////////////////
+unsigned int StarContourCache::getSize()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return (unsigned int)lookup.size();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// statistics
+///////////////////////////////////////////////////////////////////////////////
+double StarContourCache::getHitRate() const
+{
+    unsigned long long hits = hitCount.load();
+    unsigned long long total = hits + missCount.load();
+    return total > 0 ? (double)hits / total : 0.0;
+}
+
+void StarContourCache::resetStats()
+{
+    hitCount = 0;
+    missCount = 0;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// remove all contours
+///////////////////////////////////////////////////////////////////////////////
+void StarContourCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    lookup.clear();
+    contours.clear();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// remove the least recently used contours over capacity
+// mutex must be locked by caller
+///////////////////////////////////////////////////////////////////////////////
+void StarContourCache::evict()
+{
+    while(lookup.size() > capacity)
+    {
+        const StarContour& contour = *contours.back();
+        lookup.erase(makeKey(contour.pointCount, contour.mode));
+        contours.pop_back();
+    }
+}
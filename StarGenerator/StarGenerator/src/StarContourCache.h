@@ -0,0 +1,83 @@
+///////////////////////////////////////////////////////////////////////////////
+// StarContourCache.h
+// ==================
+// process-wide cache of the star contours with radius=1, keyed by the # of
+// outer points and the generate mode. A star with any radius is the scale of
+// the cached contour, so sin/cos and inner points are computed once per
+// point count.
+//
+// StarContourCache is a singleton class, constructed by calling
+// StarContourCache::getInstance(). It is thread-safe. The least recently
+// used contour is evicted when the cache is full. The contours are shared
+// by std::shared_ptr, so an evicted contour is still valid for its holders.
+//
+// Dependencies: Vector2, Star
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef STAR_CONTOUR_CACHE_H_DEF
+#define STAR_CONTOUR_CACHE_H_DEF
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "Vectors.h"
+#include "Star.h"
+
+// contour of a star with radius=1
+struct StarContour
+{
+    unsigned int pointCount;            // # of outer points (N)
+    Star::GenerateMode mode;
+    float innerRadius;                  // inner radius when radius=1
+    std::vector<Vector2> points;        // 2*N points
+};
+
+class StarContourCache
+{
+public:
+    typedef std::shared_ptr<const StarContour> ContourPtr;
+
+    ~StarContourCache();
+    static StarContourCache& getInstance();
+
+    // return the cached contour, or generate and add it if not exist
+    ContourPtr get(unsigned int pointCount, Star::GenerateMode mode=Star::GENERATE_CLOSED_FORM);
+
+    void setCapacity(unsigned int count);           // max # of contours (>= 1)
+    unsigned int getCapacity() const                { return capacity; }
+    unsigned int getSize();                         // # of cached contours
+
+    // statistics
+    unsigned long long getHitCount() const          { return hitCount.load(); }
+    unsigned long long getMissCount() const         { return missCount.load(); }
+    double getHitRate() const;
+    void resetStats();
+
+    void clear();                                   // remove all contours
+
+private:
+    StarContourCache();                             // prevent calling ctor
+    StarContourCache(const StarContourCache& rhs);  // no implementation
+    void evict();                                   // remove LRU contours over capacity
+
+    static unsigned long long makeKey(unsigned int pointCount, Star::GenerateMode mode)
+    {
+        return ((unsigned long long)pointCount << 8) | (unsigned long long)mode;
+    }
+
+    typedef std::list<ContourPtr> ContourList;      // front is most recently used
+    ContourList contours;
+    std::unordered_map<unsigned long long, ContourList::iterator> lookup;
+    std::mutex mutex;
+    unsigned int capacity;
+    std::atomic<unsigned long long> hitCount;
+    std::atomic<unsigned long long> missCount;
+};
+
+#endif
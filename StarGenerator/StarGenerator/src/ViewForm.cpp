@@ -5,7 +5,7 @@
 //
 //  AUTHORL Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2016-02-16
-// UPDATED: 2016-02-24
+// UPDATED: 2026-10-18
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <sstream>
@@ -127,7 +127,7 @@ void ViewForm::setListPoints()
     wss << std::fixed << std::setprecision(1);
 
     // print all points
-    std::vector<Vector2> points = model->getStarPoints();
+    Star::PointView points = model->getStarPoints();
     for(unsigned int i = 0; i < points.size(); ++i)
     {
         wss.str(L"");
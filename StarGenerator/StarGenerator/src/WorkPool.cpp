@@ -0,0 +1,231 @@
+///////////////////////////////////////////////////////////////////////////////
+// WorkPool.cpp
+// ============
+// thread pool to run a loop of independent iterations in parallel.
+// Each worker owns a queue of the range of iterations, and steals the back
+// half of another queue when its own queue is empty.
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include "WorkPool.h"
+
+// true while the thread is processing a job, to run nested jobs serially
+static thread_local bool inWorker = false;
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor: create threadCount-1 threads, the caller is worker 0
+///////////////////////////////////////////////////////////////////////////////
+WorkPool::WorkPool(unsigned int threadCount) : threadCount(threadCount), func(0), grain(1),
+                                               generation(0), activeCount(0), quit(false),
+                                               cancelled(false), stealCount(0)
+{
+    if(this->threadCount == 0)
+        this->threadCount = std::thread::hardware_concurrency();
+    if(this->threadCount == 0)
+        this->threadCount = 1;
+
+    queues.reset(new Queue[this->threadCount]);
+    for(unsigned int i = 0; i < this->threadCount; ++i)
+        queues[i].begin = queues[i].end = 0;
+
+    threads.reserve(this->threadCount - 1);
+    for(unsigned int i = 1; i < this->threadCount; ++i)
+        threads.push_back(std::thread(&WorkPool::workerLoop, this, i));
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// dtor: stop and join all threads
+///////////////////////////////////////////////////////////////////////////////
+WorkPool::~WorkPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quit = true;
+    }
+    startCond.notify_all();
+
+    for(size_t i = 0; i < threads.size(); ++i)
+        threads[i].join();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// instantiate a shared pool if not exist
+///////////////////////////////////////////////////////////////////////////////
+WorkPool& WorkPool::getInstance()
+{
+    static WorkPool self;
+    return self;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// split [0, count) into the queues, wake up the threads and work as worker 0,
+// then wait for the others
+///////////////////////////////////////////////////////////////////////////////
+void WorkPool::parallelFor(unsigned int count, unsigned int grain, const RangeFunc& func)
+{
+    if(count == 0)
+        return;
+    if(grain == 0)
+        grain = 1;
+
+    // not worth to wake up the threads
+    if(threadCount == 1 || inWorker || count <= grain)
+    {
+        func(0, count);
+        return;
+    }
+
+    std::lock_guard<std::mutex> jobLock(jobMutex);
+
+    for(unsigned int i = 0; i < threadCount; ++i)
+    {
+        std::lock_guard<std::mutex> lock(queues[i].mutex);
+        queues[i].begin = (unsigned int)((unsigned long long)count * i / threadCount);
+        queues[i].end = (unsigned int)((unsigned long long)count * (i + 1) / threadCount);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        this->func = &func;
+        this->grain = grain;
+        activeCount = threadCount;
+        error = std::exception_ptr();
+        cancelled = false;
+        ++generation;
+    }
+    startCond.notify_all();
+
+    runWorker(0);
+
+    std::exception_ptr e;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        doneCond.wait(lock, [this]{ return activeCount == 0; });
+        this->func = 0;
+        e = error;
+    }
+    if(e)
+        std::rethrow_exception(e);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// thread function: wait for a new job and run it, until the pool is deleted
+///////////////////////////////////////////////////////////////////////////////
+void WorkPool::workerLoop(unsigned int id)
+{
+    unsigned int done = 0;      // generation of the last job
+    while(true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            startCond.wait(lock, [this, done]{ return quit || generation != done; });
+            if(quit)
+                return;
+            done = generation;
+        }
+        runWorker(id);
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// process own chunks first, then steal from others until all queues are empty
+// A range in flight (stolen, but not put in the queue yet) is invisible to
+// the others, but it is processed by the thief, so nothing is lost.
+///////////////////////////////////////////////////////////////////////////////
+void WorkPool::runWorker(unsigned int id)
+{
+    inWorker = true;
+
+    unsigned int begin, end;
+    while(popChunk(id, begin, end) || steal(id, begin, end))
+    {
+        if(cancelled)
+            continue;       // drain the queues
+
+        try
+        {
+            (*func)(begin, end);
+        }
+        catch(...)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if(!error)
+                error = std::current_exception();
+            cancelled = true;
+        }
+    }
+
+    inWorker = false;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if(--activeCount == 0)
+        doneCond.notify_all();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// take a chunk from the front of own queue
+///////////////////////////////////////////////////////////////////////////////
+bool WorkPool::popChunk(unsigned int id, unsigned int& begin, unsigned int& end)
+{
+    Queue& queue = queues[id];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if(queue.begin >= queue.end)
+        return false;
+
+    begin = queue.begin;
+    end = (queue.end - begin > grain) ? begin + grain : queue.end;
+    queue.begin = end;
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// steal the back half of the next non-empty queue, process a chunk of it and
+// put the rest into own queue, so it can be stolen again
+///////////////////////////////////////////////////////////////////////////////
+bool WorkPool::steal(unsigned int id, unsigned int& begin, unsigned int& end)
+{
+    for(unsigned int i = 1; i < threadCount; ++i)
+    {
+        Queue& victim = queues[(id + i) % threadCount];
+        {
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if(victim.begin >= victim.end)
+                continue;
+            unsigned int count = victim.end - victim.begin;
+
+            end = victim.end;
+            begin = (count > grain) ? victim.end - count / 2 : victim.begin;
+            victim.end = begin;
+        }
+        ++stealCount;
+
+        if(end - begin > grain)
+        {
+            Queue& queue = queues[id];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.begin = begin + grain;
+            queue.end = end;
+            end = begin + grain;
+        }
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,91 @@
+///////////////////////////////////////////////////////////////////////////////
+// WorkPool.h
+// ==========
+// thread pool to run a loop of independent iterations in parallel.
+// parallelFor() splits the range [0, count) evenly into the queues of the
+// workers. Each worker takes a chunk of "grain" iterations from the front of
+// its own queue, and when it is empty, steals the back half of the queue of
+// another worker. So a worker with cheap iterations helps the others, and
+// the load is balanced without a central queue.
+//
+// The calling thread works as worker 0, so WorkPool(1) runs the loop on the
+// calling thread only. parallelFor() returns after all iterations are done.
+// A nested parallelFor() from a worker runs serially on that worker.
+//
+// WorkPool::getInstance() returns the shared pool with a worker per core.
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef WORK_POOL_H_DEF
+#define WORK_POOL_H_DEF
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkPool
+{
+public:
+    // function to process the iterations [begin, end)
+    typedef std::function<void(unsigned int begin, unsigned int end)> RangeFunc;
+
+    // ctor/dtor
+    explicit WorkPool(unsigned int threadCount=0);  // 0: # of cores
+    ~WorkPool();
+
+    static WorkPool& getInstance();                 // shared pool
+
+    // run func over [0, count) in chunks of grain iterations (>= 1)
+    // The first exception thrown by func is rethrown after all workers stop.
+    void parallelFor(unsigned int count, unsigned int grain, const RangeFunc& func);
+
+    unsigned int getThreadCount() const             { return threadCount; }     // including caller
+
+    // # of steals since the pool is created, for tuning grain size
+    unsigned long long getStealCount() const        { return stealCount.load(); }
+
+private:
+    WorkPool(const WorkPool& rhs);                  // no implementation
+
+    // range of iterations for a worker, padded to its own cache line
+    struct Queue
+    {
+        std::mutex mutex;
+        unsigned int begin;
+        unsigned int end;
+        char padding[64];
+    };
+
+    void workerLoop(unsigned int id);               // for the threads, except caller
+    void runWorker(unsigned int id);                // process iterations until all are done
+    bool popChunk(unsigned int id, unsigned int& begin, unsigned int& end);
+    bool steal(unsigned int id, unsigned int& begin, unsigned int& end);
+
+    unsigned int threadCount;
+    std::vector<std::thread> threads;
+    std::unique_ptr<Queue[]> queues;
+
+    // current job
+    std::mutex jobMutex;                            // one parallelFor() at a time
+    std::mutex mutex;                               // for the vars below
+    std::condition_variable startCond;
+    std::condition_variable doneCond;
+    const RangeFunc* func;
+    unsigned int grain;
+    unsigned int generation;                        // increased per job
+    unsigned int activeCount;                       // # of workers still running the job
+    bool quit;
+    std::exception_ptr error;
+    std::atomic<bool> cancelled;                    // skip the rest after exception
+
+    std::atomic<unsigned long long> stealCount;
+};
+
+#endif
@@ -0,0 +1,78 @@
+///////////////////////////////////////////////////////////////////////////////
+// cpuFeature.cpp
+// ==============
+// detect SIMD instruction sets at runtime, so the kernels compiled for SSE2
+// or AVX2 can be selected on the running CPU with the scalar fallback.
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include "cpuFeature.h"
+
+#if defined(CPU_X86) && defined(_MSC_VER)
+#include <intrin.h>     // for __cpuid(), _xgetbv()
+#endif
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// find the highest SIMD level
+// AVX2 also requires the OS saves YMM registers (OSXSAVE and XCR0 bit 1,2).
+///////////////////////////////////////////////////////////////////////////////
+int detectSimdLevel()
+{
+#if defined(CPU_X86) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    int maxId = info[0];
+
+    __cpuid(info, 1);
+    bool sse2 = (info[3] & (1 << 26)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    bool fma = (info[2] & (1 << 12)) != 0;
+    bool avx2 = false;
+    if(maxId >= 7)
+    {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+    }
+    bool ymm = osxsave && ((_xgetbv(0) & 6) == 6);
+
+    if(avx && avx2 && fma && ymm)
+        return SIMD_AVX2;
+    if(sse2)
+        return SIMD_SSE2;
+    return SIMD_SCALAR;
+
+#elif defined(CPU_X86) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return SIMD_AVX2;
+    if(__builtin_cpu_supports("sse2"))
+        return SIMD_SSE2;
+    return SIMD_SCALAR;
+
+#else
+    return SIMD_SCALAR;
+#endif
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return the name of SIMD level
+///////////////////////////////////////////////////////////////////////////////
+const char* getSimdLevelName(int level)
+{
+    switch(level)
+    {
+    case SIMD_AVX2:
+        return "avx2";
+    case SIMD_SSE2:
+        return "sse2";
+    default:
+        return "scalar";
+    }
+}
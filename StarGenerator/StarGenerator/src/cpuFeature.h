@@ -0,0 +1,49 @@
+///////////////////////////////////////////////////////////////////////////////
+// cpuFeature.h
+// ============
+// detect SIMD instruction sets at runtime, so the kernels compiled for SSE2
+// or AVX2 can be selected on the running CPU with the scalar fallback.
+//
+// TARGET_AVX2 must be prefixed to a function using AVX2 intrinsics. GCC and
+// Clang do not allow AVX2 intrinsics without the target attribute unless
+// the whole file is compiled with -mavx2. MSVC does not need it.
+// TARGET_AVX is for the kernels needing AVX only. It does not enable FMA, so
+// the kernel can run on AVX CPUs without FMA, and can be inlined into the
+// callers compiled with -mavx.
+// TARGET_AVX2_NO_FMA is for the AVX2 kernels that must give the same results
+// as the scalar code. GCC fuses _mm256_mul_ps() and _mm256_add_ps() to FMA if
+// it is enabled, which rounds once instead of twice.
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef CPU_FEATURE_H
+#define CPU_FEATURE_H
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define CPU_X86 1
+#endif
+
+#if defined(CPU_X86) && (defined(__GNUC__) || defined(__clang__))
+#define TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define TARGET_AVX  __attribute__((target("avx")))
+#define TARGET_AVX2_NO_FMA __attribute__((target("avx2")))
+#else
+#define TARGET_AVX2
+#define TARGET_AVX
+#define TARGET_AVX2_NO_FMA
+#endif
+
+// SIMD levels, higher includes lower
+enum
+{
+    SIMD_SCALAR = 0,
+    SIMD_SSE2,
+    SIMD_AVX2
+};
+
+int detectSimdLevel();                          // highest level supported by CPU and OS
+const char* getSimdLevelName(int level);        // "scalar", "sse2", "avx2"
+
+#endif
@@ -11,11 +11,13 @@
 // GL_ARB_framebuffer_object
 // GL_ARB_debug_output
 // GL_ARB_direct_state_access
+// GL_ARB_draw_instanced, GL_ARB_instanced_arrays
 // GL_ARB_multisample
 // GL_ARB_multitexture
 // GL_ARB_pixel_buffer_objects, GL_ARB_vertex_buffer_object
 // GL_ARB_shader_objects, GL_ARB_vertex_program, GL_ARB_fragment_program, GL_ARB_vertex_shader, GL_ARB_fragment_shader
 // GL_ARB_sync
+// GL_ARB_timer_query
 // GL_ARB_vertex_array_object
 // WGL_ARB_extensions_string
 // WGL_ARB_pixel_format
@@ -24,7 +26,7 @@
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2013-03-05
-// UPDATED: 2018-06-07
+// UPDATED: 2026-10-18
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <iostream>
@@ -162,6 +164,13 @@ PFNGLWAITSYNCPROC           pglWaitSync = 0;
 PFNGLGETINTEGER64VPROC      pglGetInteger64v = 0;
 PFNGLGETSYNCIVPROC          pglGetSynciv = 0;
 
+// GL_ARB_timer_query
+PFNGLGENQUERIESPROC             pglGenQueries = 0;
+PFNGLDELETEQUERIESPROC          pglDeleteQueries = 0;
+PFNGLQUERYCOUNTERPROC           pglQueryCounter = 0;
+PFNGLGETQUERYOBJECTIVPROC       pglGetQueryObjectiv = 0;
+PFNGLGETQUERYOBJECTUI64VPROC    pglGetQueryObjectui64v = 0;
+
 // GL_ARB_vertex_array_object
 PFNGLGENVERTEXARRAYSPROC    pglGenVertexArrays = 0;     // VAO name generation procedure
 PFNGLDELETEVERTEXARRAYSPROC pglDeleteVertexArrays = 0;  // VAO deletion procedure
@@ -294,6 +303,11 @@ PFNGLDEBUGMESSAGEINSERTARBPROC   pglDebugMessageInsertARB = 0;
 PFNGLDEBUGMESSAGECALLBACKARBPROC pglDebugMessageCallbackARB = 0;
 PFNGLGETDEBUGMESSAGELOGARBPROC   pglGetDebugMessageLogARB = 0;
 
+// GL_ARB_draw_instanced & GL_ARB_instanced_arrays
+PFNGLDRAWARRAYSINSTANCEDARBPROC     pglDrawArraysInstancedARB = 0;      // draw N instances of arrays
+PFNGLDRAWELEMENTSINSTANCEDARBPROC   pglDrawElementsInstancedARB = 0;    // draw N instances of elements
+PFNGLVERTEXATTRIBDIVISORARBPROC     pglVertexAttribDivisorARB = 0;      // advance attrib per instance
+
 // GL_ARB_direct_state_access
 PFNGLCREATETRANSFORMFEEDBACKSPROC                 pglCreateTransformFeedbacks = 0; // for transform feedback object
 PFNGLTRANSFORMFEEDBACKBUFFERBASEPROC              pglTransformFeedbackBufferBase = 0;
@@ -690,6 +704,16 @@ void glExtension::getFunctionPointers()
             glGetInteger64v     = (PFNGLGETINTEGER64VPROC)wglGetProcAddress("glGetInteger64v");
             glGetSynciv         = (PFNGLGETSYNCIVPROC)wglGetProcAddress("glGetSynciv");
         }
+        else if(extensions[i] == "GL_ARB_timer_query")
+        {
+            glGenQueries            = (PFNGLGENQUERIESPROC)wglGetProcAddress("glGenQueries");
+            glDeleteQueries         = (PFNGLDELETEQUERIESPROC)wglGetProcAddress("glDeleteQueries");
+            glQueryCounter          = (PFNGLQUERYCOUNTERPROC)wglGetProcAddress("glQueryCounter");
+            glGetQueryObjectiv      = (PFNGLGETQUERYOBJECTIVPROC)wglGetProcAddress("glGetQueryObjectiv");
+            glGetQueryObjectui64v   = (PFNGLGETQUERYOBJECTUI64VPROC)wglGetProcAddress("glGetQueryObjectui64v");
+            if(!glGetInteger64v)    // also in GL_ARB_sync
+                glGetInteger64v     = (PFNGLGETINTEGER64VPROC)wglGetProcAddress("glGetInteger64v");
+        }
         else if(extensions[i] == "GL_ARB_vertex_array_object")
         {
             glGenVertexArrays       = (PFNGLGENVERTEXARRAYSPROC)wglGetProcAddress("glGenVertexArrays");
@@ -825,6 +849,15 @@ void glExtension::getFunctionPointers()
             glDebugMessageCallbackARB = (PFNGLDEBUGMESSAGECALLBACKARBPROC)wglGetProcAddress("glDebugMessageCallbackARB");
             glGetDebugMessageLogARB   = (PFNGLGETDEBUGMESSAGELOGARBPROC)wglGetProcAddress("glGetDebugMessageLogARB");
         }
+        else if(extensions[i] == "GL_ARB_draw_instanced")
+        {
+            glDrawArraysInstancedARB    = (PFNGLDRAWARRAYSINSTANCEDARBPROC)wglGetProcAddress("glDrawArraysInstancedARB");
+            glDrawElementsInstancedARB  = (PFNGLDRAWELEMENTSINSTANCEDARBPROC)wglGetProcAddress("glDrawElementsInstancedARB");
+        }
+        else if(extensions[i] == "GL_ARB_instanced_arrays")
+        {
+            glVertexAttribDivisorARB    = (PFNGLVERTEXATTRIBDIVISORARBPROC)wglGetProcAddress("glVertexAttribDivisorARB");
+        }
         else if(extensions[i] == "GL_ARB_direct_state_access")
         {
              // for transform feedback object
@@ -11,11 +11,13 @@
 // GL_ARB_framebuffer_object
 // GL_ARB_debug_output
 // GL_ARB_direct_state_access
+// GL_ARB_draw_instanced, GL_ARB_instanced_arrays
 // GL_ARB_multisample
 // GL_ARB_multitexture
 // GL_ARB_pixel_buffer_objects, GL_ARB_vertex_buffer_object
 // GL_ARB_shader_objects, GL_ARB_vertex_program, GL_ARB_fragment_program, GL_ARB_vertex_shader, GL_ARB_fragment_shader
 // GL_ARB_sync
+// GL_ARB_timer_query
 // GL_ARB_vertex_array_object
 // WGL_ARB_extensions_string
 // WGL_ARB_pixel_format
@@ -24,7 +26,7 @@
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2013-03-05
-// UPDATED: 2018-06-07
+// UPDATED: 2026-10-18
 ///////////////////////////////////////////////////////////////////////////////
 
 #ifndef GL_EXTENSION_H
@@ -43,6 +45,11 @@
 #ifdef __APPLE__
 #include <OpenGL/gl.h>
 #else
+// Mesa's gl.h includes its own glext.h unless GL_GLEXT_LEGACY is defined,
+// then GL_GLEXT_VERSION of the local glext.h is redefined
+#ifndef GL_GLEXT_LEGACY
+#define GL_GLEXT_LEGACY
+#endif
 #include <GL/gl.h>
 #endif
 
@@ -321,6 +328,18 @@ extern PFNGLGETSYNCIVPROC       pglGetSynciv;
 #define glGetInteger64v         pglGetInteger64v
 #define glGetSynciv             pglGetSynciv
 
+// GL_ARB_timer_query (with query objects of GL 1.5)
+extern PFNGLGENQUERIESPROC          pglGenQueries;
+extern PFNGLDELETEQUERIESPROC       pglDeleteQueries;
+extern PFNGLQUERYCOUNTERPROC        pglQueryCounter;
+extern PFNGLGETQUERYOBJECTIVPROC    pglGetQueryObjectiv;
+extern PFNGLGETQUERYOBJECTUI64VPROC pglGetQueryObjectui64v;
+#define glGenQueries                pglGenQueries
+#define glDeleteQueries             pglDeleteQueries
+#define glQueryCounter              pglQueryCounter
+#define glGetQueryObjectiv          pglGetQueryObjectiv
+#define glGetQueryObjectui64v       pglGetQueryObjectui64v
+
 // GL_ARB_vertex_array_object
 extern PFNGLGENVERTEXARRAYSPROC     pglGenVertexArrays;     // VAO name generation procedure
 extern PFNGLDELETEVERTEXARRAYSPROC  pglDeleteVertexArrays;  // VAO deletion procedure
@@ -573,6 +592,14 @@ extern PFNGLGETDEBUGMESSAGELOGARBPROC   pglGetDebugMessageLogARB;
 #define glDebugMessageCallbackARB       pglDebugMessageCallbackARB
 #define glGetDebugMessageLogARB         pglGetDebugMessageLogARB
 
+// GL_ARB_draw_instanced & GL_ARB_instanced_arrays
+extern PFNGLDRAWARRAYSINSTANCEDARBPROC      pglDrawArraysInstancedARB;      // draw N instances of arrays
+extern PFNGLDRAWELEMENTSINSTANCEDARBPROC    pglDrawElementsInstancedARB;    // draw N instances of elements
+extern PFNGLVERTEXATTRIBDIVISORARBPROC      pglVertexAttribDivisorARB;      // advance attrib per instance
+#define glDrawArraysInstancedARB            pglDrawArraysInstancedARB
+#define glDrawElementsInstancedARB          pglDrawElementsInstancedARB
+#define glVertexAttribDivisorARB            pglVertexAttribDivisorARB
+
 // GL_ARB_direct_state_access
 extern PFNGLCREATETRANSFORMFEEDBACKSPROC                 pglCreateTransformFeedbacks; // for transform feedback object
 extern PFNGLTRANSFORMFEEDBACKBUFFERBASEPROC              pglTransformFeedbackBufferBase;
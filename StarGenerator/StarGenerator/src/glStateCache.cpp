@@ -0,0 +1,209 @@
+///////////////////////////////////////////////////////////////////////////////
+// glStateCache.cpp
+// ================
+// cache of OpenGL states to skip redundant state changes
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include "glStateCache.h"
+
+// tracked caps and client states, the others are passed through
+const GLenum TRACKED_CAPS[] = {GL_LIGHTING, GL_DEPTH_TEST, GL_CULL_FACE, GL_BLEND, GL_TEXTURE_2D, GL_LIGHT0};
+const GLenum TRACKED_CLIENT_STATES[] = {GL_VERTEX_ARRAY, GL_NORMAL_ARRAY, GL_COLOR_ARRAY};
+const GLenum TRACKED_TARGETS[] = {GL_ARRAY_BUFFER_ARB, GL_ELEMENT_ARRAY_BUFFER_ARB};
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor
+///////////////////////////////////////////////////////////////////////////////
+glStateCache::glStateCache() : issuedCount(0), skippedCount(0)
+{
+    for(int i = 0; i < CAP_COUNT; ++i)
+        caps[i].name = TRACKED_CAPS[i];
+    for(int i = 0; i < CLIENT_STATE_COUNT; ++i)
+        clientStates[i].name = TRACKED_CLIENT_STATES[i];
+    for(int i = 0; i < BINDING_COUNT; ++i)
+        bindings[i].target = TRACKED_TARGETS[i];
+
+    invalidate();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// mark all states unknown, the next changes are issued
+///////////////////////////////////////////////////////////////////////////////
+void glStateCache::invalidate()
+{
+    for(int i = 0; i < CAP_COUNT; ++i)
+        caps[i].value = -1;
+    for(int i = 0; i < CLIENT_STATE_COUNT; ++i)
+        clientStates[i].value = -1;
+    for(int i = 0; i < BINDING_COUNT; ++i)
+    {
+        bindings[i].buffer = 0;
+        bindings[i].known = false;
+    }
+
+    lineWidthValue = -1;
+    pointSizeValue = -1;
+    program = 0;
+    programKnown = false;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// glEnable/glDisable if the cap is changed
+///////////////////////////////////////////////////////////////////////////////
+void glStateCache::setCap(GLenum cap, bool flag)
+{
+    int value = flag ? 1 : 0;
+    int i = 0;
+    for(; i < CAP_COUNT; ++i)
+    {
+        if(caps[i].name != cap)
+            continue;
+
+        if(skip(caps[i].value == value))
+            return;
+        caps[i].value = value;
+        break;
+    }
+    if(i == CAP_COUNT)
+        ++issuedCount;      // not tracked
+
+    if(flag)
+        glEnable(cap);
+    else
+        glDisable(cap);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// glEnableClientState/glDisableClientState if the state is changed
+///////////////////////////////////////////////////////////////////////////////
+void glStateCache::setClientState(GLenum array, bool flag)
+{
+    int value = flag ? 1 : 0;
+    int i = 0;
+    for(; i < CLIENT_STATE_COUNT; ++i)
+    {
+        if(clientStates[i].name != array)
+            continue;
+
+        if(skip(clientStates[i].value == value))
+            return;
+        clientStates[i].value = value;
+        break;
+    }
+    if(i == CLIENT_STATE_COUNT)
+        ++issuedCount;      // not tracked
+
+    if(flag)
+        glEnableClientState(array);
+    else
+        glDisableClientState(array);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// set line width and point size
+///////////////////////////////////////////////////////////////////////////////
+void glStateCache::lineWidth(GLfloat width)
+{
+    if(skip(lineWidthValue == width))
+        return;
+
+    lineWidthValue = width;
+    glLineWidth(width);
+}
+
+void glStateCache::pointSize(GLfloat size)
+{
+    if(skip(pointSizeValue == size))
+        return;
+
+    pointSizeValue = size;
+    glPointSize(size);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// set shader program
+///////////////////////////////////////////////////////////////////////////////
+void glStateCache::useProgram(GLhandleARB program)
+{
+    if(skip(programKnown && this->program == program))
+        return;
+
+    this->program = program;
+    programKnown = true;
+    glUseProgramObjectARB(program);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// bind buffer object to the target
+///////////////////////////////////////////////////////////////////////////////
+void glStateCache::bindBuffer(GLenum target, GLuint buffer)
+{
+    int i = 0;
+    for(; i < BINDING_COUNT; ++i)
+    {
+        if(bindings[i].target != target)
+            continue;
+
+        if(skip(bindings[i].known && bindings[i].buffer == buffer))
+            return;
+        bindings[i].buffer = buffer;
+        bindings[i].known = true;
+        break;
+    }
+    if(i == BINDING_COUNT)
+        ++issuedCount;      // not tracked
+
+    glBindBufferARB(target, buffer);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// delete buffer objects
+// OpenGL rebinds 0 to the targets of a deleted buffer, and the name can be
+// reused by the next glGenBuffersARB(), so the cache must forget it.
+///////////////////////////////////////////////////////////////////////////////
+void glStateCache::deleteBuffers(GLsizei n, const GLuint* buffers)
+{
+    for(GLsizei i = 0; i < n; ++i)
+    {
+        for(int j = 0; j < BINDING_COUNT; ++j)
+        {
+            if(buffers[i] != 0 && bindings[j].buffer == buffers[i])
+                bindings[j].buffer = 0;
+        }
+    }
+
+    glDeleteBuffersARB(n, buffers);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// count the call as skipped if the state is same, otherwise as issued
+///////////////////////////////////////////////////////////////////////////////
+bool glStateCache::skip(bool same)
+{
+    if(same)
+        ++skippedCount;
+    else
+        ++issuedCount;
+    return same;
+}
@@ -0,0 +1,88 @@
+///////////////////////////////////////////////////////////////////////////////
+// glStateCache.h
+// ==============
+// cache of OpenGL states to skip redundant state changes
+// It remembers the last value set for each tracked state, and calls OpenGL
+// only if the new value is different. The # of issued and skipped calls are
+// counted to measure the redundant state changes.
+//
+// All states are unknown at the beginning (or after invalidate()), so the
+// first change of each state is always issued. Call invalidate() if other
+// code changes the states without this cache.
+//
+// tracked states: glEnable/glDisable caps, client states, line width, point
+// size, shader program and buffer bindings of array/element array.
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef GL_STATE_CACHE_H
+#define GL_STATE_CACHE_H
+
+#include "glExtension.h"
+
+class glStateCache
+{
+public:
+    glStateCache();
+    ~glStateCache() {}
+
+    void invalidate();                              // forget all states
+
+    // glEnable/glDisable
+    void enable(GLenum cap)                         { setCap(cap, true); }
+    void disable(GLenum cap)                        { setCap(cap, false); }
+
+    // glEnableClientState/glDisableClientState
+    void enableClientState(GLenum array)            { setClientState(array, true); }
+    void disableClientState(GLenum array)           { setClientState(array, false); }
+
+    void lineWidth(GLfloat width);
+    void pointSize(GLfloat size);
+    void useProgram(GLhandleARB program);           // glUseProgramObjectARB
+    void bindBuffer(GLenum target, GLuint buffer);  // glBindBufferARB
+    void deleteBuffers(GLsizei n, const GLuint* buffers);  // glDeleteBuffersARB, unbind if bound
+
+    // counters
+    unsigned int getIssuedCount() const             { return issuedCount; }
+    unsigned int getSkippedCount() const            { return skippedCount; }
+    void resetCounters()                            { issuedCount = skippedCount = 0; }
+
+private:
+    // on/off state of a cap or client state, -1 is unknown
+    struct Entry
+    {
+        GLenum name;
+        int value;
+    };
+
+    // bound buffer of a target
+    struct Binding
+    {
+        GLenum target;
+        GLuint buffer;
+        bool known;
+    };
+
+    void setCap(GLenum cap, bool flag);
+    void setClientState(GLenum array, bool flag);
+    bool skip(bool same);                           // count and return same
+
+    static const int CAP_COUNT = 6;
+    static const int CLIENT_STATE_COUNT = 3;
+    static const int BINDING_COUNT = 2;
+
+    Entry caps[CAP_COUNT];
+    Entry clientStates[CLIENT_STATE_COUNT];
+    Binding bindings[BINDING_COUNT];
+    GLfloat lineWidthValue;                         // < 0 is unknown
+    GLfloat pointSizeValue;
+    GLhandleARB program;
+    bool programKnown;
+
+    unsigned int issuedCount;
+    unsigned int skippedCount;
+};
+
+#endif
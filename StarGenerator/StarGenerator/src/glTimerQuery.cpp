@@ -0,0 +1,178 @@
+///////////////////////////////////////////////////////////////////////////////
+// glTimerQuery.cpp
+// ================
+// GPU time of the draw passes with timestamp queries (GL_ARB_timer_query)
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include "glTimerQuery.h"
+#include "FrameProfiler.h"
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor
+///////////////////////////////////////////////////////////////////////////////
+glTimerQuery::glTimerQuery() : current(0), supported(false), active(false), droppedFrameCount(0)
+{
+    for(int i = 0; i < FRAME_LATENCY; ++i)
+    {
+        frames[i].passCount = 0;
+        frames[i].pending = false;
+        frames[i].frame = 0;
+        frames[i].offset = 0;
+        frames[i].lastQuery = 0;
+        for(int j = 0; j < MAX_PASSES; ++j)
+        {
+            frames[i].passes[j].name = 0;
+            frames[i].passes[j].queries[0] = frames[i].passes[j].queries[1] = 0;
+        }
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// create 2 queries per pass for all frames in flight
+///////////////////////////////////////////////////////////////////////////////
+bool glTimerQuery::init()
+{
+    quit();
+
+    supported = glExtension::getInstance().isSupported("GL_ARB_timer_query");
+    if(!supported)
+        return false;
+
+    for(int i = 0; i < FRAME_LATENCY; ++i)
+    {
+        for(int j = 0; j < MAX_PASSES; ++j)
+            glGenQueries(2, frames[i].passes[j].queries);
+    }
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// delete queries, the pending results are dropped
+///////////////////////////////////////////////////////////////////////////////
+void glTimerQuery::quit()
+{
+    for(int i = 0; i < FRAME_LATENCY; ++i)
+    {
+        for(int j = 0; j < MAX_PASSES; ++j)
+        {
+            GLuint* queries = frames[i].passes[j].queries;
+            if(queries[0])
+                glDeleteQueries(2, queries);
+            queries[0] = queries[1] = 0;
+        }
+        frames[i].passCount = 0;
+        frames[i].pending = false;
+    }
+    current = 0;
+    active = false;
+    supported = false;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// read the oldest frame before reusing its queries, then sample the offset of
+// GPU clock to CPU clock for this frame
+///////////////////////////////////////////////////////////////////////////////
+void glTimerQuery::beginFrame()
+{
+    if(!supported)
+        return;
+
+    Frame& frame = frames[current];
+    if(frame.pending)
+        readFrame(frame);
+    frame.passCount = 0;
+
+    FrameProfiler& profiler = FrameProfiler::getInstance();
+    active = profiler.isEnabled();
+    if(!active)
+        return;
+
+    GLint64 gpuTime = 0;
+    glGetInteger64v(GL_TIMESTAMP, &gpuTime);
+    frame.offset = (long long)profiler.now() - (long long)gpuTime;
+    frame.frame = profiler.getFrame();
+}
+
+void glTimerQuery::endFrame()
+{
+    if(!supported)
+        return;
+
+    // move to the next frame even if not timed, so the frames in flight are
+    // read after the profiler is disabled
+    frames[current].pending = active && frames[current].passCount > 0;
+    current = (current + 1) % FRAME_LATENCY;
+    active = false;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// timestamps around a pass
+///////////////////////////////////////////////////////////////////////////////
+int glTimerQuery::beginPass(const char* name)
+{
+    Frame& frame = frames[current];
+    if(!active || frame.passCount >= MAX_PASSES)
+        return -1;
+
+    int pass = frame.passCount++;
+    frame.passes[pass].name = name;
+    glQueryCounter(frame.passes[pass].queries[0], GL_TIMESTAMP);
+    frame.lastQuery = frame.passes[pass].queries[0];
+    return pass;
+}
+
+void glTimerQuery::endPass(int pass)
+{
+    if(pass < 0 || !active)
+        return;
+
+    Frame& frame = frames[current];
+    glQueryCounter(frame.passes[pass].queries[1], GL_TIMESTAMP);
+    frame.lastQuery = frame.passes[pass].queries[1];
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// record the passes of the frame if the last issued query is available
+// The queries complete in order, so the last one is enough to check.
+///////////////////////////////////////////////////////////////////////////////
+void glTimerQuery::readFrame(Frame& frame)
+{
+    frame.pending = false;
+
+    GLint available = 0;
+    glGetQueryObjectiv(frame.lastQuery, GL_QUERY_RESULT_AVAILABLE, &available);
+    if(!available)
+    {
+        ++droppedFrameCount;
+        return;
+    }
+
+    FrameProfiler& profiler = FrameProfiler::getInstance();
+    for(int i = 0; i < frame.passCount; ++i)
+    {
+        GLuint64 begin = 0, end = 0;
+        glGetQueryObjectui64v(frame.passes[i].queries[0], GL_QUERY_RESULT, &begin);
+        glGetQueryObjectui64v(frame.passes[i].queries[1], GL_QUERY_RESULT, &end);
+
+        long long start = (long long)begin + frame.offset;
+        if(start < 0)
+            start = 0;
+        profiler.record(frame.passes[i].name, (unsigned long long)start,
+                        (unsigned long long)start + (end - begin), FrameProfiler::TRACK_GPU, frame.frame);
+    }
+}
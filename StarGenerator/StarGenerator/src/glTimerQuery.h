@@ -0,0 +1,99 @@
+///////////////////////////////////////////////////////////////////////////////
+// glTimerQuery.h
+// ==============
+// GPU time of the draw passes with timestamp queries (GL_ARB_timer_query)
+// beginPass()/endPass() put glQueryCounter(GL_TIMESTAMP) into the command
+// stream, and the results are read FRAME_LATENCY frames later, so reading
+// them does not stall the pipeline. If the results of a frame are not ready
+// by then, the frame is dropped instead of waiting.
+//
+// The GPU timestamps are moved to the timeline of FrameProfiler with the
+// offset between GL_TIMESTAMP and the CPU clock sampled at beginFrame(), and
+// recorded on the GPU track with the frame number of the draw.
+//
+// The queries are issued only if FrameProfiler is enabled, otherwise
+// beginPass()/endPass() return immediately.
+//
+// Dependencies: glExtension, FrameProfiler
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef GL_TIMER_QUERY_H
+#define GL_TIMER_QUERY_H
+
+#include "glExtension.h"
+
+class glTimerQuery
+{
+public:
+    enum { FRAME_LATENCY = 4, MAX_PASSES = 16 };
+
+    glTimerQuery();
+    ~glTimerQuery() {}
+
+    bool init();                                    // create queries, must be called after RC is open
+    void quit();                                    // delete queries
+    bool isSupported() const                        { return supported; }
+
+    // record the results of FRAME_LATENCY frames ago, then start a frame
+    void beginFrame();
+    void endFrame();
+
+    // timestamps around a pass, returns -1 if not timed
+    int beginPass(const char* name);                // name must be a string literal
+    void endPass(int pass);
+
+    unsigned int getDroppedFrameCount() const       { return droppedFrameCount; }
+
+private:
+    glTimerQuery(const glTimerQuery& rhs);          // no implementation
+    glTimerQuery& operator=(const glTimerQuery& rhs);
+
+    struct Pass
+    {
+        const char* name;
+        GLuint queries[2];                          // begin, end
+    };
+
+    struct Frame
+    {
+        Pass passes[MAX_PASSES];
+        int passCount;
+        bool pending;                               // issued, not read yet
+        unsigned int frame;                         // FrameProfiler frame number
+        long long offset;                           // CPU ns - GPU ns
+        GLuint lastQuery;                           // issued last, passes can nest
+    };
+
+    void readFrame(Frame& frame);
+
+    Frame frames[FRAME_LATENCY];
+    int current;
+    bool supported;
+    bool active;                                    // timing the current frame
+    unsigned int droppedFrameCount;
+};
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// time the GPU commands of a scope
+// usage: { glTimerScope gpu(timer, "grid"); drawGrid(); }
+///////////////////////////////////////////////////////////////////////////////
+class glTimerScope
+{
+public:
+    glTimerScope(glTimerQuery& timer, const char* name) : timer(timer), pass(timer.beginPass(name)) {}
+    ~glTimerScope()                                 { timer.endPass(pass); }
+
+private:
+    glTimerScope(const glTimerScope& rhs);          // no implementation
+    glTimerScope& operator=(const glTimerScope& rhs);
+
+    glTimerQuery& timer;
+    int pass;
+};
+
+#endif
@@ -0,0 +1,394 @@
+///////////////////////////////////////////////////////////////////////////////
+// pointKernels.cpp
+// ================
+// vectorized kernels to modify arrays of 2D points in one pass.
+// The points are either interleaved (x0,y0,x1,y1,..., same as Vector2 array)
+// or separate x[] and y[] arrays. SSE2 or AVX2 version is selected at runtime
+// by detectSimdLevel(), and the scalar version is used on other CPUs.
+//
+// All loads/stores are unaligned, because std::vector<Vector2> is not aligned
+// at 16/32 bytes. The remaining elements at the end are done by scalar code.
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <cmath>
+#include "pointKernels.h"
+#include "cpuFeature.h"
+
+#ifdef CPU_X86
+#include <immintrin.h>
+#endif
+
+// global vars
+static std::atomic<int> kernelLevel(-1);        // -1: not detected yet
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// select kernels
+///////////////////////////////////////////////////////////////////////////////
+int getPointKernelLevel()
+{
+    int level = kernelLevel.load(std::memory_order_relaxed);
+    if(level < 0)
+    {
+        level = detectSimdLevel();
+        kernelLevel.store(level, std::memory_order_relaxed);
+    }
+    return level;
+}
+
+void setPointKernelLevel(int level)
+{
+    int maxLevel = detectSimdLevel();
+    if(level < SIMD_SCALAR || level > maxLevel)
+        level = maxLevel;
+    kernelLevel.store(level, std::memory_order_relaxed);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// scalar kernels
+///////////////////////////////////////////////////////////////////////////////
+static void scaleOddPointsScalar(float* xy, unsigned int begin, unsigned int pointCount, float radius)
+{
+    // start from odd index
+    for(unsigned int i = begin | 1; i < pointCount; i += 2)
+    {
+        float x = xy[2*i];
+        float y = xy[2*i+1];
+        float scale = radius / sqrtf(x*x + y*y);
+        xy[2*i] = x * scale;
+        xy[2*i+1] = y * scale;
+    }
+}
+
+static void scaleOddPointsScalar(float* x, float* y, unsigned int begin, unsigned int pointCount, float radius)
+{
+    for(unsigned int i = begin | 1; i < pointCount; i += 2)
+    {
+        float scale = radius / sqrtf(x[i]*x[i] + y[i]*y[i]);
+        x[i] *= scale;
+        y[i] *= scale;
+    }
+}
+
+static void roundPointsScalar(float* values, unsigned int begin, unsigned int count)
+{
+    for(unsigned int i = begin; i < count; ++i)
+        values[i] = (float)round(values[i]);
+}
+
+static void scalePointsScalar(const float* src, float* dst, unsigned int begin, unsigned int count, float scale)
+{
+    for(unsigned int i = begin; i < count; ++i)
+        dst[i] = src[i] * scale;
+}
+
+static void scalePointsScalar(const float* xy, float* x, float* y, unsigned int begin, unsigned int pointCount, float scale)
+{
+    for(unsigned int i = begin; i < pointCount; ++i)
+    {
+        x[i] = xy[2*i] * scale;
+        y[i] = xy[2*i+1] * scale;
+    }
+}
+
+static void transformPointsScalar(const float* src, float* dst, unsigned int begin, unsigned int pointCount,
+                                  float scale, float x, float y)
+{
+    for(unsigned int i = begin; i < pointCount; ++i)
+    {
+        dst[2*i]   = src[2*i] * scale + x;
+        dst[2*i+1] = src[2*i+1] * scale + y;
+    }
+}
+
+
+
+#ifdef CPU_X86
+///////////////////////////////////////////////////////////////////////////////
+// SSE2 kernels
+///////////////////////////////////////////////////////////////////////////////
+// interleaved: 4 floats = 2 points, the 2nd point (lane 2,3) is odd
+static unsigned int scaleOddPointsSse2(float* xy, unsigned int pointCount, float radius)
+{
+    const __m128 r = _mm_set1_ps(radius);
+    const __m128 mask = _mm_castsi128_ps(_mm_set_epi32(-1, -1, 0, 0));
+    unsigned int i;
+    for(i = 0; i + 2 <= pointCount; i += 2)
+    {
+        __m128 v = _mm_loadu_ps(xy + 2*i);
+        __m128 sq = _mm_mul_ps(v, v);
+        __m128 len = _mm_sqrt_ps(_mm_add_ps(sq, _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(2,3,0,1))));
+        __m128 s = _mm_mul_ps(v, _mm_div_ps(r, len));
+        _mm_storeu_ps(xy + 2*i, _mm_or_ps(_mm_and_ps(mask, s), _mm_andnot_ps(mask, v)));
+    }
+    return i;
+}
+
+// separate: 4 points per register, lane 1,3 are odd
+static unsigned int scaleOddPointsSse2(float* x, float* y, unsigned int pointCount, float radius)
+{
+    const __m128 r = _mm_set1_ps(radius);
+    const __m128 mask = _mm_castsi128_ps(_mm_set_epi32(-1, 0, -1, 0));
+    unsigned int i;
+    for(i = 0; i + 4 <= pointCount; i += 4)
+    {
+        __m128 vx = _mm_loadu_ps(x + i);
+        __m128 vy = _mm_loadu_ps(y + i);
+        __m128 len = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)));
+        __m128 scale = _mm_div_ps(r, len);
+        __m128 sx = _mm_mul_ps(vx, scale);
+        __m128 sy = _mm_mul_ps(vy, scale);
+        _mm_storeu_ps(x + i, _mm_or_ps(_mm_and_ps(mask, sx), _mm_andnot_ps(mask, vx)));
+        _mm_storeu_ps(y + i, _mm_or_ps(_mm_and_ps(mask, sy), _mm_andnot_ps(mask, vy)));
+    }
+    return i;
+}
+
+// round half away from zero: trunc(v + copysign(0.49999997, v))
+// SSE2 has no trunc for float, so convert to int and back, and keep the
+// values >= 2^23 as they are (already integer, and may overflow int)
+static unsigned int roundPointsSse2(float* values, unsigned int count)
+{
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    const __m128 half = _mm_set1_ps(0.49999997f);
+    const __m128 big = _mm_set1_ps(8388608.0f);     // 2^23
+    unsigned int i;
+    for(i = 0; i + 4 <= count; i += 4)
+    {
+        __m128 v = _mm_loadu_ps(values + i);
+        __m128 sign = _mm_and_ps(v, signMask);
+        __m128 t = _mm_add_ps(v, _mm_or_ps(half, sign));
+        __m128 r = _mm_cvtepi32_ps(_mm_cvttps_epi32(t));
+        r = _mm_or_ps(r, sign);                     // keep -0.0
+        __m128 isBig = _mm_cmpnlt_ps(_mm_andnot_ps(signMask, v), big);   // or NaN
+        _mm_storeu_ps(values + i, _mm_or_ps(_mm_and_ps(isBig, v), _mm_andnot_ps(isBig, r)));
+    }
+    return i;
+}
+
+static unsigned int scalePointsSse2(const float* src, float* dst, unsigned int count, float scale)
+{
+    const __m128 s = _mm_set1_ps(scale);
+    unsigned int i;
+    for(i = 0; i + 4 <= count; i += 4)
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(src + i), s));
+    return i;
+}
+
+// [x0 y0 x1 y1] [x2 y2 x3 y3] -> [x0 x1 x2 x3] [y0 y1 y2 y3]
+static unsigned int scalePointsSse2(const float* xy, float* x, float* y, unsigned int pointCount, float scale)
+{
+    const __m128 s = _mm_set1_ps(scale);
+    unsigned int i;
+    for(i = 0; i + 4 <= pointCount; i += 4)
+    {
+        __m128 v0 = _mm_loadu_ps(xy + 2*i);
+        __m128 v1 = _mm_loadu_ps(xy + 2*i + 4);
+        _mm_storeu_ps(x + i, _mm_mul_ps(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(2,0,2,0)), s));
+        _mm_storeu_ps(y + i, _mm_mul_ps(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(3,1,3,1)), s));
+    }
+    return i;
+}
+
+// 4 floats = 2 points
+static unsigned int transformPointsSse2(const float* src, float* dst, unsigned int pointCount,
+                                        float scale, float x, float y)
+{
+    const __m128 s = _mm_set1_ps(scale);
+    const __m128 t = _mm_setr_ps(x, y, x, y);
+    unsigned int i;
+    for(i = 0; i + 2 <= pointCount; i += 2)
+        _mm_storeu_ps(dst + 2*i, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(src + 2*i), s), t));
+    return i;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// AVX2 kernels
+///////////////////////////////////////////////////////////////////////////////
+// interleaved: 8 floats = 4 points, lane 2,3,6,7 are odd points
+TARGET_AVX2_NO_FMA
+static unsigned int scaleOddPointsAvx2(float* xy, unsigned int pointCount, float radius)
+{
+    const __m256 r = _mm256_set1_ps(radius);
+    unsigned int i;
+    for(i = 0; i + 4 <= pointCount; i += 4)
+    {
+        __m256 v = _mm256_loadu_ps(xy + 2*i);
+        __m256 sq = _mm256_mul_ps(v, v);
+        __m256 len = _mm256_sqrt_ps(_mm256_add_ps(sq, _mm256_permute_ps(sq, _MM_SHUFFLE(2,3,0,1))));
+        __m256 s = _mm256_mul_ps(v, _mm256_div_ps(r, len));
+        _mm256_storeu_ps(xy + 2*i, _mm256_blend_ps(v, s, 0xCC));
+    }
+    return i;
+}
+
+// separate: 8 points per register, lane 1,3,5,7 are odd
+TARGET_AVX2_NO_FMA
+static unsigned int scaleOddPointsAvx2(float* x, float* y, unsigned int pointCount, float radius)
+{
+    const __m256 r = _mm256_set1_ps(radius);
+    unsigned int i;
+    for(i = 0; i + 8 <= pointCount; i += 8)
+    {
+        __m256 vx = _mm256_loadu_ps(x + i);
+        __m256 vy = _mm256_loadu_ps(y + i);
+        __m256 len = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(vx, vx), _mm256_mul_ps(vy, vy)));
+        __m256 scale = _mm256_div_ps(r, len);
+        _mm256_storeu_ps(x + i, _mm256_blend_ps(vx, _mm256_mul_ps(vx, scale), 0xAA));
+        _mm256_storeu_ps(y + i, _mm256_blend_ps(vy, _mm256_mul_ps(vy, scale), 0xAA));
+    }
+    return i;
+}
+
+TARGET_AVX2_NO_FMA
+static unsigned int roundPointsAvx2(float* values, unsigned int count)
+{
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    const __m256 half = _mm256_set1_ps(0.49999997f);
+    unsigned int i;
+    for(i = 0; i + 8 <= count; i += 8)
+    {
+        __m256 v = _mm256_loadu_ps(values + i);
+        __m256 t = _mm256_add_ps(v, _mm256_or_ps(half, _mm256_and_ps(v, signMask)));
+        _mm256_storeu_ps(values + i, _mm256_round_ps(t, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+    }
+    return i;
+}
+
+TARGET_AVX2_NO_FMA
+static unsigned int scalePointsAvx2(const float* src, float* dst, unsigned int count, float scale)
+{
+    const __m256 s = _mm256_set1_ps(scale);
+    unsigned int i;
+    for(i = 0; i + 8 <= count; i += 8)
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_loadu_ps(src + i), s));
+    return i;
+}
+
+// shuffle gives [x0 x1 x4 x5 | x2 x3 x6 x7], then reorder 64-bit blocks
+TARGET_AVX2_NO_FMA
+static unsigned int scalePointsAvx2(const float* xy, float* x, float* y, unsigned int pointCount, float scale)
+{
+    const __m256 s = _mm256_set1_ps(scale);
+    unsigned int i;
+    for(i = 0; i + 8 <= pointCount; i += 8)
+    {
+        __m256 v0 = _mm256_loadu_ps(xy + 2*i);
+        __m256 v1 = _mm256_loadu_ps(xy + 2*i + 8);
+        __m256 vx = _mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(2,0,2,0));
+        __m256 vy = _mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(3,1,3,1));
+        vx = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(vx), _MM_SHUFFLE(3,1,2,0)));
+        vy = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(vy), _MM_SHUFFLE(3,1,2,0)));
+        _mm256_storeu_ps(x + i, _mm256_mul_ps(vx, s));
+        _mm256_storeu_ps(y + i, _mm256_mul_ps(vy, s));
+    }
+    return i;
+}
+
+// 8 floats = 4 points
+TARGET_AVX2_NO_FMA
+static unsigned int transformPointsAvx2(const float* src, float* dst, unsigned int pointCount,
+                                        float scale, float x, float y)
+{
+    const __m256 s = _mm256_set1_ps(scale);
+    const __m256 t = _mm256_setr_ps(x, y, x, y, x, y, x, y);
+    unsigned int i;
+    for(i = 0; i + 4 <= pointCount; i += 4)
+        _mm256_storeu_ps(dst + 2*i, _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(src + 2*i), s), t));
+    return i;
+}
+#endif
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// dispatchers
+// SIMD kernel processes the most of the array, then scalar does the rest
+///////////////////////////////////////////////////////////////////////////////
+void scaleOddPoints(float* xy, unsigned int pointCount, float radius)
+{
+    unsigned int done = 0;
+#ifdef CPU_X86
+    int level = getPointKernelLevel();
+    if(level >= SIMD_AVX2)
+        done = scaleOddPointsAvx2(xy, pointCount, radius);
+    else if(level >= SIMD_SSE2)
+        done = scaleOddPointsSse2(xy, pointCount, radius);
+#endif
+    scaleOddPointsScalar(xy, done, pointCount, radius);
+}
+
+void scaleOddPoints(float* x, float* y, unsigned int pointCount, float radius)
+{
+    unsigned int done = 0;
+#ifdef CPU_X86
+    int level = getPointKernelLevel();
+    if(level >= SIMD_AVX2)
+        done = scaleOddPointsAvx2(x, y, pointCount, radius);
+    else if(level >= SIMD_SSE2)
+        done = scaleOddPointsSse2(x, y, pointCount, radius);
+#endif
+    scaleOddPointsScalar(x, y, done, pointCount, radius);
+}
+
+void roundPoints(float* values, unsigned int count)
+{
+    unsigned int done = 0;
+#ifdef CPU_X86
+    int level = getPointKernelLevel();
+    if(level >= SIMD_AVX2)
+        done = roundPointsAvx2(values, count);
+    else if(level >= SIMD_SSE2)
+        done = roundPointsSse2(values, count);
+#endif
+    roundPointsScalar(values, done, count);
+}
+
+
+void scalePoints(const float* src, float* dst, unsigned int count, float scale)
+{
+    unsigned int done = 0;
+#ifdef CPU_X86
+    int level = getPointKernelLevel();
+    if(level >= SIMD_AVX2)
+        done = scalePointsAvx2(src, dst, count, scale);
+    else if(level >= SIMD_SSE2)
+        done = scalePointsSse2(src, dst, count, scale);
+#endif
+    scalePointsScalar(src, dst, done, count, scale);
+}
+
+void scalePoints(const float* xy, float* x, float* y, unsigned int pointCount, float scale)
+{
+    unsigned int done = 0;
+#ifdef CPU_X86
+    int level = getPointKernelLevel();
+    if(level >= SIMD_AVX2)
+        done = scalePointsAvx2(xy, x, y, pointCount, scale);
+    else if(level >= SIMD_SSE2)
+        done = scalePointsSse2(xy, x, y, pointCount, scale);
+#endif
+    scalePointsScalar(xy, x, y, done, pointCount, scale);
+}
+
+void transformPoints(const float* src, float* dst, unsigned int pointCount, float scale, float x, float y)
+{
+    unsigned int done = 0;
+#ifdef CPU_X86
+    int level = getPointKernelLevel();
+    if(level >= SIMD_AVX2)
+        done = transformPointsAvx2(src, dst, pointCount, scale, x, y);
+    else if(level >= SIMD_SSE2)
+        done = transformPointsSse2(src, dst, pointCount, scale, x, y);
+#endif
+    transformPointsScalar(src, dst, done, pointCount, scale, x, y);
+}
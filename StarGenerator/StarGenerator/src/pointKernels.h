@@ -0,0 +1,40 @@
+///////////////////////////////////////////////////////////////////////////////
+// pointKernels.h
+// ==============
+// vectorized kernels to modify arrays of 2D points in one pass.
+// The points are either interleaved (x0,y0,x1,y1,..., same as Vector2 array)
+// or separate x[] and y[] arrays. SSE2 or AVX2 version is selected at runtime
+// by detectSimdLevel(), and the scalar version is used on other CPUs.
+//
+// The results are same as the scalar code in Star class, the AVX2 kernels are
+// compiled without FMA, so a multiply-add is rounded twice as in scalar code;
+// - scaleOddPoints() = radius * Vector2::normalize() for odd-index points
+// - roundPoints() = round(), halfway cases are rounded away from zero
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef POINT_KERNELS_H
+#define POINT_KERNELS_H
+
+// move the odd-index points onto the circle with radius
+void scaleOddPoints(float* xy, unsigned int pointCount, float radius);           // interleaved
+void scaleOddPoints(float* x, float* y, unsigned int pointCount, float radius);  // separate
+
+// round each value to the nearest integer
+void roundPoints(float* values, unsigned int count);
+
+// copy the points multiplied by scale, interleaved to interleaved or separate
+void scalePoints(const float* src, float* dst, unsigned int count, float scale);
+void scalePoints(const float* xy, float* x, float* y, unsigned int pointCount, float scale);
+
+// copy the interleaved points multiplied by scale then moved by (x, y)
+void transformPoints(const float* src, float* dst, unsigned int pointCount, float scale, float x, float y);
+
+// select the kernels, it cannot be higher than detectSimdLevel()
+// It is for comparing the kernels, the default is the highest level.
+void setPointKernelLevel(int level);
+int getPointKernelLevel();
+
+#endif
@@ -0,0 +1,299 @@
+///////////////////////////////////////////////////////////////////////////////
+// rasterKernels.cpp
+// =================
+// vectorized kernels to rasterize triangles into a RGBA8 framebuffer with
+// edge functions.
+//
+// All kernels evaluate E = a*(x - ox) + b*(y - oy) at the pixel center in
+// the same order. The terms are exact for small triangles, so the compiler
+// may fuse them to FMA in the AVX2 kernel without changing the result. Opaque
+// colors are written with masked stores, translucent colors
+// are blended per covered pixel.
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include "rasterKernels.h"
+#include "cpuFeature.h"
+
+#ifdef CPU_X86
+#include <immintrin.h>
+#endif
+
+// constants
+const float SUBPIXEL = 16.0f;                   // vertex precision, 1/16 pixel
+
+// global vars
+static std::atomic<int> kernelLevel(-1);        // -1: not detected yet
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// select kernels
+///////////////////////////////////////////////////////////////////////////////
+int getRasterKernelLevel()
+{
+    int level = kernelLevel.load(std::memory_order_relaxed);
+    if(level < 0)
+    {
+        level = detectSimdLevel();
+        kernelLevel.store(level, std::memory_order_relaxed);
+    }
+    return level;
+}
+
+void setRasterKernelLevel(int level)
+{
+    int maxLevel = detectSimdLevel();
+    if(level < SIMD_SCALAR || level > maxLevel)
+        level = maxLevel;
+    kernelLevel.store(level, std::memory_order_relaxed);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// setup edge functions, the vertices are reordered to make the area positive
+///////////////////////////////////////////////////////////////////////////////
+bool setupTriangle(float x0, float y0, float x1, float y1, float x2, float y2,
+                   int width, int height, RasterTriangle& triangle)
+{
+    x0 = std::floor(x0 * SUBPIXEL + 0.5f) / SUBPIXEL;
+    y0 = std::floor(y0 * SUBPIXEL + 0.5f) / SUBPIXEL;
+    x1 = std::floor(x1 * SUBPIXEL + 0.5f) / SUBPIXEL;
+    y1 = std::floor(y1 * SUBPIXEL + 0.5f) / SUBPIXEL;
+    x2 = std::floor(x2 * SUBPIXEL + 0.5f) / SUBPIXEL;
+    y2 = std::floor(y2 * SUBPIXEL + 0.5f) / SUBPIXEL;
+
+    float area = (x1 - x0) * (y2 - y0) - (y1 - y0) * (x2 - x0);
+    if(!(area != 0) || !std::isfinite(area))
+        return false;
+    if(area < 0)
+    {
+        std::swap(x1, x2);
+        std::swap(y1, y2);
+    }
+
+    const float xs[3] = {x0, x1, x2};
+    const float ys[3] = {y0, y1, y2};
+    for(int i = 0; i < 3; ++i)
+    {
+        int j = (i + 1) % 3;
+        triangle.a[i] = ys[i] - ys[j];
+        triangle.b[i] = xs[j] - xs[i];
+        // same origin for both directions of the edge
+        int k = (ys[i] < ys[j] || (ys[i] == ys[j] && xs[i] < xs[j])) ? i : j;
+        triangle.ox[i] = xs[k];
+        triangle.oy[i] = ys[k];
+        triangle.topLeft[i] = triangle.a[i] > 0 || (triangle.a[i] == 0 && triangle.b[i] > 0);
+    }
+
+    // pixels whose centers are in the bbox of triangle
+    float minX = std::min(x0, std::min(x1, x2));
+    float maxX = std::max(x0, std::max(x1, x2));
+    float minY = std::min(y0, std::min(y1, y2));
+    float maxY = std::max(y0, std::max(y1, y2));
+    triangle.bounds[0] = std::max(0, (int)std::ceil(minX - 0.5f));
+    triangle.bounds[1] = std::max(0, (int)std::ceil(minY - 0.5f));
+    triangle.bounds[2] = std::min(width, (int)std::floor(maxX - 0.5f) + 1);
+    triangle.bounds[3] = std::min(height, (int)std::floor(maxY - 0.5f) + 1);
+    return triangle.bounds[0] < triangle.bounds[2] && triangle.bounds[1] < triangle.bounds[3];
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// scalar kernel
+///////////////////////////////////////////////////////////////////////////////
+static void rasterizeTriangleScalar(const RasterTriangle& t, unsigned char* pixels, int stride,
+                                    int x0, int y0, int x1, int y1, const float color[4])
+{
+    for(int y = y0; y < y1; ++y)
+    {
+        float py = y + 0.5f;
+        float c0 = t.b[0] * (py - t.oy[0]);
+        float c1 = t.b[1] * (py - t.oy[1]);
+        float c2 = t.b[2] * (py - t.oy[2]);
+        unsigned char* pixel = pixels + (size_t)y * stride + x0 * 4;
+        for(int x = x0; x < x1; ++x, pixel += 4)
+        {
+            float px = x + 0.5f;
+            float e0 = t.a[0] * (px - t.ox[0]) + c0;
+            float e1 = t.a[1] * (px - t.ox[1]) + c1;
+            float e2 = t.a[2] * (px - t.ox[2]) + c2;
+            if((e0 > 0 || (e0 == 0 && t.topLeft[0])) &&
+               (e1 > 0 || (e1 == 0 && t.topLeft[1])) &&
+               (e2 > 0 || (e2 == 0 && t.topLeft[2])))
+                blendPixel(pixel, color, 1);
+        }
+    }
+}
+
+
+
+#ifdef CPU_X86
+///////////////////////////////////////////////////////////////////////////////
+// SSE2 kernel, 4 pixels at once, covered pixels are written one by one
+///////////////////////////////////////////////////////////////////////////////
+static inline __m128 insideSse2(__m128 e, __m128 topLeft)
+{
+    const __m128 zero = _mm_setzero_ps();
+    return _mm_or_ps(_mm_cmpgt_ps(e, zero), _mm_and_ps(_mm_cmpeq_ps(e, zero), topLeft));
+}
+
+static void rasterizeTriangleSse2(const RasterTriangle& t, unsigned char* pixels, int stride,
+                                  int x0, int y0, int x1, int y1, const float color[4])
+{
+    const __m128 a0 = _mm_set1_ps(t.a[0]);
+    const __m128 a1 = _mm_set1_ps(t.a[1]);
+    const __m128 a2 = _mm_set1_ps(t.a[2]);
+    const __m128 ox0 = _mm_set1_ps(t.ox[0]);
+    const __m128 ox1 = _mm_set1_ps(t.ox[1]);
+    const __m128 ox2 = _mm_set1_ps(t.ox[2]);
+    const __m128 tl0 = _mm_castsi128_ps(_mm_set1_epi32(t.topLeft[0] ? -1 : 0));
+    const __m128 tl1 = _mm_castsi128_ps(_mm_set1_epi32(t.topLeft[1] ? -1 : 0));
+    const __m128 tl2 = _mm_castsi128_ps(_mm_set1_epi32(t.topLeft[2] ? -1 : 0));
+    const __m128 laneOffset = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+
+    for(int y = y0; y < y1; ++y)
+    {
+        float py = y + 0.5f;
+        const __m128 c0 = _mm_set1_ps(t.b[0] * (py - t.oy[0]));
+        const __m128 c1 = _mm_set1_ps(t.b[1] * (py - t.oy[1]));
+        const __m128 c2 = _mm_set1_ps(t.b[2] * (py - t.oy[2]));
+        unsigned char* row = pixels + (size_t)y * stride;
+        for(int x = x0; x < x1; x += 4)
+        {
+            __m128 px = _mm_add_ps(_mm_set1_ps((float)x), laneOffset);
+            __m128 e0 = _mm_add_ps(_mm_mul_ps(a0, _mm_sub_ps(px, ox0)), c0);
+            __m128 e1 = _mm_add_ps(_mm_mul_ps(a1, _mm_sub_ps(px, ox1)), c1);
+            __m128 e2 = _mm_add_ps(_mm_mul_ps(a2, _mm_sub_ps(px, ox2)), c2);
+            __m128 inside = _mm_and_ps(_mm_and_ps(insideSse2(e0, tl0), insideSse2(e1, tl1)), insideSse2(e2, tl2));
+
+            int mask = _mm_movemask_ps(inside);
+            if(x1 - x < 4)
+                mask &= (1 << (x1 - x)) - 1;
+            for(; mask; mask &= mask - 1)
+            {
+                int lane = 0;
+                while(!(mask & (1 << lane)))
+                    ++lane;
+                blendPixel(row + (x + lane) * 4, color, 1);
+            }
+        }
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// AVX2 kernel, 8 pixels at once
+// Opaque color is written with a masked store of 8 packed pixels.
+///////////////////////////////////////////////////////////////////////////////
+TARGET_AVX2
+static inline __m256 insideAvx2(__m256 e, __m256 topLeft)
+{
+    const __m256 zero = _mm256_setzero_ps();
+    return _mm256_or_ps(_mm256_cmp_ps(e, zero, _CMP_GT_OQ),
+                        _mm256_and_ps(_mm256_cmp_ps(e, zero, _CMP_EQ_OQ), topLeft));
+}
+
+TARGET_AVX2
+static void rasterizeTriangleAvx2(const RasterTriangle& t, unsigned char* pixels, int stride,
+                                  int x0, int y0, int x1, int y1, const float color[4])
+{
+    const __m256 a0 = _mm256_set1_ps(t.a[0]);
+    const __m256 a1 = _mm256_set1_ps(t.a[1]);
+    const __m256 a2 = _mm256_set1_ps(t.a[2]);
+    const __m256 ox0 = _mm256_set1_ps(t.ox[0]);
+    const __m256 ox1 = _mm256_set1_ps(t.ox[1]);
+    const __m256 ox2 = _mm256_set1_ps(t.ox[2]);
+    const __m256 tl0 = _mm256_castsi256_ps(_mm256_set1_epi32(t.topLeft[0] ? -1 : 0));
+    const __m256 tl1 = _mm256_castsi256_ps(_mm256_set1_epi32(t.topLeft[1] ? -1 : 0));
+    const __m256 tl2 = _mm256_castsi256_ps(_mm256_set1_epi32(t.topLeft[2] ? -1 : 0));
+    const __m256 laneOffset = _mm256_setr_ps(0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f);
+    const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+    // packed color for opaque fill, same bytes as blendPixel() with alpha 1
+    const bool opaque = color[3] >= 1.0f;
+    unsigned char bytes[4] = {0, 0, 0, 0};
+    if(opaque)
+        blendPixel(bytes, color, 1);
+    int packed;
+    std::memcpy(&packed, bytes, 4);
+    const __m256i packedColor = _mm256_set1_epi32(packed);
+
+    for(int y = y0; y < y1; ++y)
+    {
+        float py = y + 0.5f;
+        const __m256 c0 = _mm256_set1_ps(t.b[0] * (py - t.oy[0]));
+        const __m256 c1 = _mm256_set1_ps(t.b[1] * (py - t.oy[1]));
+        const __m256 c2 = _mm256_set1_ps(t.b[2] * (py - t.oy[2]));
+        unsigned char* row = pixels + (size_t)y * stride;
+        for(int x = x0; x < x1; x += 8)
+        {
+            __m256 px = _mm256_add_ps(_mm256_set1_ps((float)x), laneOffset);
+            __m256 e0 = _mm256_add_ps(_mm256_mul_ps(a0, _mm256_sub_ps(px, ox0)), c0);
+            __m256 e1 = _mm256_add_ps(_mm256_mul_ps(a1, _mm256_sub_ps(px, ox1)), c1);
+            __m256 e2 = _mm256_add_ps(_mm256_mul_ps(a2, _mm256_sub_ps(px, ox2)), c2);
+            __m256 inside = _mm256_and_ps(_mm256_and_ps(insideAvx2(e0, tl0), insideAvx2(e1, tl1)),
+                                          insideAvx2(e2, tl2));
+
+            // lanes beyond x1
+            __m256i valid = _mm256_cmpgt_epi32(_mm256_set1_epi32(x1 - x), lanes);
+            __m256i mask = _mm256_and_si256(_mm256_castps_si256(inside), valid);
+            if(_mm256_testz_si256(mask, mask))
+                continue;
+
+            if(opaque)
+            {
+                _mm256_maskstore_epi32((int*)(row + x * 4), mask, packedColor);
+                continue;
+            }
+            for(int bits = _mm256_movemask_ps(_mm256_castsi256_ps(mask)); bits; bits &= bits - 1)
+            {
+                int lane = 0;
+                while(!(bits & (1 << lane)))
+                    ++lane;
+                blendPixel(row + (x + lane) * 4, color, 1);
+            }
+        }
+    }
+}
+#endif
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// dispatcher, the region is clipped to the bbox of triangle
+///////////////////////////////////////////////////////////////////////////////
+void rasterizeTriangle(const RasterTriangle& triangle, unsigned char* pixels, int stride,
+                       int x0, int y0, int x1, int y1, const float color[4])
+{
+    x0 = std::max(x0, triangle.bounds[0]);
+    y0 = std::max(y0, triangle.bounds[1]);
+    x1 = std::min(x1, triangle.bounds[2]);
+    y1 = std::min(y1, triangle.bounds[3]);
+    if(x0 >= x1 || y0 >= y1)
+        return;
+
+#ifdef CPU_X86
+    int level = getRasterKernelLevel();
+    if(level >= SIMD_AVX2)
+    {
+        rasterizeTriangleAvx2(triangle, pixels, stride, x0, y0, x1, y1, color);
+        return;
+    }
+    else if(level >= SIMD_SSE2)
+    {
+        rasterizeTriangleSse2(triangle, pixels, stride, x0, y0, x1, y1, color);
+        return;
+    }
+#endif
+    rasterizeTriangleScalar(triangle, pixels, stride, x0, y0, x1, y1, color);
+}
@@ -0,0 +1,596 @@
+///////////////////////////////////////////////////////////////////////////////
+// transformKernels.cpp
+// ====================
+// vectorized kernels to transform arrays of 3D/4D points by a Matrix4
+//
+// SoA:     4 (SSE2) or 8 (AVX2) points at once, each output is a dot product
+//          of a row of the matrix and (x, y, z, 1).
+// Vector4: a point (SSE2) or 2 points (AVX2) at once, the output is a linear
+//          combination of the columns of the matrix, same as Matrix4 * Vector4.
+// Vector3: AVX2 loads 8 points (24 floats), de-interleaves them into x[],
+//          y[], z[] with blends and permutes, then same as SoA. SSE2 does a
+//          point at once like Vector4.
+// TRS:     sin/cos of 4 (SSE2) or 8 (AVX2) angles at once, then each matrix
+//          is stored as 4 columns. The angle is reduced to [-45, 45] degrees
+//          and a quadrant, so multiples of 90 degrees are exact.
+//
+// All loads/stores are unaligned. The remaining points at the end are done by
+// scalar code.
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <cmath>
+#include "transformKernels.h"
+#include "cpuFeature.h"
+#include "WorkPool.h"
+
+#ifdef CPU_X86
+#include <immintrin.h>
+#endif
+
+// global vars
+static std::atomic<int> kernelLevel(-1);        // -1: not detected yet
+
+// constants for sin/cos polynomials in [-pi/4, pi/4] (Cephes)
+const float DEG2RAD = 3.14159265f / 180.0f;
+const float SIN_C0 = -1.6666654611e-1f;
+const float SIN_C1 =  8.3321608736e-3f;
+const float SIN_C2 = -1.9515295891e-4f;
+const float COS_C0 =  4.166664568298827e-2f;
+const float COS_C1 = -1.388731625493765e-3f;
+const float COS_C2 =  2.443315711809948e-5f;
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// select kernels
+///////////////////////////////////////////////////////////////////////////////
+int getTransformKernelLevel()
+{
+    int level = kernelLevel.load(std::memory_order_relaxed);
+    if(level < 0)
+    {
+        level = detectSimdLevel();
+        kernelLevel.store(level, std::memory_order_relaxed);
+    }
+    return level;
+}
+
+void setTransformKernelLevel(int level)
+{
+    int maxLevel = detectSimdLevel();
+    if(level < SIMD_SCALAR || level > maxLevel)
+        level = maxLevel;
+    kernelLevel.store(level, std::memory_order_relaxed);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// run func for [0, count), split into the threads if count is large
+///////////////////////////////////////////////////////////////////////////////
+static void runRange(unsigned int count, WorkPool* pool, const WorkPool::RangeFunc& func,
+                     unsigned int minCount=TRANSFORM_PARALLEL_COUNT)
+{
+    if(count < minCount)
+    {
+        func(0, count);
+        return;
+    }
+
+    if(!pool)
+        pool = &WorkPool::getInstance();
+    pool->parallelFor(count, minCount / 4, func);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// scalar kernels
+///////////////////////////////////////////////////////////////////////////////
+static inline void transformPointScalar(const float* m, float x, float y, float z,
+                                        float& dstX, float& dstY, float& dstZ, bool project)
+{
+    float tx = m[0]*x + m[4]*y + m[8]*z  + m[12];
+    float ty = m[1]*x + m[5]*y + m[9]*z  + m[13];
+    float tz = m[2]*x + m[6]*y + m[10]*z + m[14];
+    if(project)
+    {
+        float invW = 1.0f / (m[3]*x + m[7]*y + m[11]*z + m[15]);
+        tx *= invW;
+        ty *= invW;
+        tz *= invW;
+    }
+    dstX = tx;
+    dstY = ty;
+    dstZ = tz;
+}
+
+static void transformPoints3Scalar(const float* m, const float* src, float* dst,
+                                   unsigned int begin, unsigned int end, bool project)
+{
+    for(unsigned int i = 3 * begin; i < 3 * end; i += 3)
+        transformPointScalar(m, src[i], src[i+1], src[i+2], dst[i], dst[i+1], dst[i+2], project);
+}
+
+static void transformPoints4Scalar(const float* m, const float* src, float* dst,
+                                   unsigned int begin, unsigned int end)
+{
+    for(unsigned int i = 4 * begin; i < 4 * end; i += 4)
+        transformVector4Scalar(m, src[i], src[i+1], src[i+2], src[i+3], &dst[i]);
+}
+
+static void transformPointsSoAScalar(const float* m, const float* x, const float* y, const float* z,
+                                     float* dstX, float* dstY, float* dstZ,
+                                     unsigned int begin, unsigned int end, bool project)
+{
+    for(unsigned int i = begin; i < end; ++i)
+        transformPointScalar(m, x[i], y[i], z[i], dstX[i], dstY[i], dstZ[i], project);
+}
+
+// sin/cos of angle(degree)
+// q = round(angle / 90), r = angle - 90q in [-45, 45], then rotate (sin r, cos r)
+// by q quadrants: q=1: (cos r, -sin r), q=2: (-sin r, -cos r), q=3: (-cos r, sin r)
+static inline void sinCosScalar(float angle, float& sine, float& cosine)
+{
+    float q = std::nearbyint(angle * (1.0f / 90.0f));
+    float x = (angle - q * 90.0f) * DEG2RAD;
+    float x2 = x * x;
+    float s = x + x * x2 * (SIN_C0 + x2 * (SIN_C1 + x2 * SIN_C2));
+    float c = 1.0f - 0.5f * x2 + x2 * x2 * (COS_C0 + x2 * (COS_C1 + x2 * COS_C2));
+
+    int quadrant = (int)q;
+    if(quadrant & 1)
+    {
+        float t = s;
+        s = c;
+        c = -t;
+    }
+    if(quadrant & 2)
+    {
+        s = -s;
+        c = -c;
+    }
+    sine = s;
+    cosine = c;
+}
+
+// write T * Rz * S matrix from sin * scale, cos * scale
+static inline void storeTransformScalar(float* m, const Vector3& p, float sinScale, float cosScale, float scale)
+{
+    m[0] = cosScale;    m[4] = -sinScale;   m[8] = 0;       m[12] = p.x;
+    m[1] = sinScale;    m[5] = cosScale;    m[9] = 0;       m[13] = p.y;
+    m[2] = 0;           m[6] = 0;           m[10]= scale;   m[14] = p.z;
+    m[3] = 0;           m[7] = 0;           m[11]= 0;       m[15] = 1;
+}
+
+static void buildTransformsScalar(const Vector3* positions, const float* angles, const float* scales,
+                                  float* matrices, unsigned int begin, unsigned int end)
+{
+    for(unsigned int i = begin; i < end; ++i)
+    {
+        float s, c;
+        sinCosScalar(angles[i], s, c);
+        storeTransformScalar(matrices + 16 * i, positions[i], s * scales[i], c * scales[i], scales[i]);
+    }
+}
+
+
+
+#ifdef CPU_X86
+///////////////////////////////////////////////////////////////////////////////
+// SSE2 kernels
+///////////////////////////////////////////////////////////////////////////////
+static void transformPoints3Sse2(const float* m, const float* src, float* dst,
+                                 unsigned int begin, unsigned int end, bool project)
+{
+    const __m128 c0 = _mm_loadu_ps(m);
+    const __m128 c1 = _mm_loadu_ps(m + 4);
+    const __m128 c2 = _mm_loadu_ps(m + 8);
+    const __m128 c3 = _mm_loadu_ps(m + 12);
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    float v[4];
+    for(unsigned int i = 3 * begin; i < 3 * end; i += 3)
+    {
+        __m128 r = _mm_mul_ps(c0, _mm_set1_ps(src[i]));
+        r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_set1_ps(src[i+1])));
+        r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(src[i+2])));
+        r = _mm_add_ps(r, c3);
+        if(project)
+            r = _mm_mul_ps(r, _mm_div_ps(one, _mm_shuffle_ps(r, r, 0xff)));
+        _mm_storeu_ps(v, r);
+        dst[i]   = v[0];
+        dst[i+1] = v[1];
+        dst[i+2] = v[2];
+    }
+}
+
+static void transformPoints4Sse2(const float* m, const float* src, float* dst,
+                                 unsigned int begin, unsigned int end)
+{
+    const __m128 c0 = _mm_loadu_ps(m);
+    const __m128 c1 = _mm_loadu_ps(m + 4);
+    const __m128 c2 = _mm_loadu_ps(m + 8);
+    const __m128 c3 = _mm_loadu_ps(m + 12);
+
+    for(unsigned int i = 4 * begin; i < 4 * end; i += 4)
+    {
+        __m128 v = _mm_loadu_ps(src + i);
+        __m128 r = _mm_mul_ps(c0, _mm_shuffle_ps(v, v, 0x00));
+        r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_shuffle_ps(v, v, 0x55)));
+        r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_shuffle_ps(v, v, 0xaa)));
+        r = _mm_add_ps(r, _mm_mul_ps(c3, _mm_shuffle_ps(v, v, 0xff)));
+        _mm_storeu_ps(dst + i, r);
+    }
+}
+
+static void transformPointsSoASse2(const float* m, const float* x, const float* y, const float* z,
+                                   float* dstX, float* dstY, float* dstZ,
+                                   unsigned int begin, unsigned int end, bool project)
+{
+    __m128 row[16];
+    for(int j = 0; j < 16; ++j)
+        row[j] = _mm_set1_ps(m[j]);
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    unsigned int i = begin;
+    for(; i + 4 <= end; i += 4)
+    {
+        __m128 px = _mm_loadu_ps(x + i);
+        __m128 py = _mm_loadu_ps(y + i);
+        __m128 pz = _mm_loadu_ps(z + i);
+        __m128 tx = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(row[0], px), _mm_mul_ps(row[4], py)), _mm_mul_ps(row[8], pz)), row[12]);
+        __m128 ty = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(row[1], px), _mm_mul_ps(row[5], py)), _mm_mul_ps(row[9], pz)), row[13]);
+        __m128 tz = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(row[2], px), _mm_mul_ps(row[6], py)), _mm_mul_ps(row[10], pz)), row[14]);
+        if(project)
+        {
+            __m128 tw = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(row[3], px), _mm_mul_ps(row[7], py)), _mm_mul_ps(row[11], pz)), row[15]);
+            __m128 invW = _mm_div_ps(one, tw);
+            tx = _mm_mul_ps(tx, invW);
+            ty = _mm_mul_ps(ty, invW);
+            tz = _mm_mul_ps(tz, invW);
+        }
+        _mm_storeu_ps(dstX + i, tx);
+        _mm_storeu_ps(dstY + i, ty);
+        _mm_storeu_ps(dstZ + i, tz);
+    }
+    transformPointsSoAScalar(m, x, y, z, dstX, dstY, dstZ, i, end, project);
+}
+
+// sin/cos of 4 angles(degree), same as sinCosScalar()
+static inline void sinCos4Sse2(__m128 angle, __m128& sine, __m128& cosine)
+{
+    __m128i quadrant = _mm_cvtps_epi32(_mm_mul_ps(angle, _mm_set1_ps(1.0f / 90.0f)));
+    __m128 q = _mm_cvtepi32_ps(quadrant);
+    __m128 x = _mm_mul_ps(_mm_sub_ps(angle, _mm_mul_ps(q, _mm_set1_ps(90.0f))), _mm_set1_ps(DEG2RAD));
+    __m128 x2 = _mm_mul_ps(x, x);
+
+    __m128 s = _mm_add_ps(_mm_mul_ps(x2, _mm_set1_ps(SIN_C2)), _mm_set1_ps(SIN_C1));
+    s = _mm_add_ps(_mm_mul_ps(x2, s), _mm_set1_ps(SIN_C0));
+    s = _mm_add_ps(x, _mm_mul_ps(_mm_mul_ps(x, x2), s));
+    __m128 c = _mm_add_ps(_mm_mul_ps(x2, _mm_set1_ps(COS_C2)), _mm_set1_ps(COS_C1));
+    c = _mm_add_ps(_mm_mul_ps(x2, c), _mm_set1_ps(COS_C0));
+    c = _mm_add_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(_mm_set1_ps(0.5f), x2)), _mm_mul_ps(_mm_mul_ps(x2, x2), c));
+
+    // swap if q is odd, then flip the sign of sin if bit 1 of q is set, and
+    // the sign of cos if bit 0 xor bit 1 is set
+    __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+    __m128 t = s;
+    s = _mm_or_ps(_mm_and_ps(swap, c), _mm_andnot_ps(swap, s));
+    c = _mm_or_ps(_mm_and_ps(swap, t), _mm_andnot_ps(swap, c));
+    __m128i signS = _mm_slli_epi32(_mm_srli_epi32(quadrant, 1), 31);
+    __m128i signC = _mm_slli_epi32(_mm_xor_si128(quadrant, _mm_srli_epi32(quadrant, 1)), 31);
+    sine = _mm_xor_ps(s, _mm_castsi128_ps(signS));
+    cosine = _mm_xor_ps(c, _mm_castsi128_ps(signC));
+}
+
+static void buildTransformsSse2(const Vector3* positions, const float* angles, const float* scales,
+                                float* matrices, unsigned int begin, unsigned int end)
+{
+    alignas(16) float sinScale[4];
+    alignas(16) float cosScale[4];
+
+    unsigned int i = begin;
+    for(; i + 4 <= end; i += 4)
+    {
+        __m128 s, c;
+        sinCos4Sse2(_mm_loadu_ps(angles + i), s, c);
+        __m128 scale = _mm_loadu_ps(scales + i);
+        _mm_store_ps(sinScale, _mm_mul_ps(s, scale));
+        _mm_store_ps(cosScale, _mm_mul_ps(c, scale));
+
+        float* m = matrices + 16 * i;
+        for(int j = 0; j < 4; ++j, m += 16)
+        {
+            const Vector3& p = positions[i + j];
+            _mm_storeu_ps(m,      _mm_setr_ps(cosScale[j], sinScale[j], 0, 0));
+            _mm_storeu_ps(m + 4,  _mm_setr_ps(-sinScale[j], cosScale[j], 0, 0));
+            _mm_storeu_ps(m + 8,  _mm_setr_ps(0, 0, scales[i + j], 0));
+            _mm_storeu_ps(m + 12, _mm_setr_ps(p.x, p.y, p.z, 1));
+        }
+    }
+    buildTransformsScalar(positions, angles, scales, matrices, i, end);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// AVX2 kernels
+///////////////////////////////////////////////////////////////////////////////
+// 8 points of SoA, returns (x', y', z') in px, py, pz
+TARGET_AVX2
+static inline void transform8Avx2(const __m256* row, __m256& px, __m256& py, __m256& pz, bool project)
+{
+    __m256 tx = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(row[0], px), _mm256_mul_ps(row[4], py)), _mm256_mul_ps(row[8], pz)), row[12]);
+    __m256 ty = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(row[1], px), _mm256_mul_ps(row[5], py)), _mm256_mul_ps(row[9], pz)), row[13]);
+    __m256 tz = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(row[2], px), _mm256_mul_ps(row[6], py)), _mm256_mul_ps(row[10], pz)), row[14]);
+    if(project)
+    {
+        __m256 tw = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(row[3], px), _mm256_mul_ps(row[7], py)), _mm256_mul_ps(row[11], pz)), row[15]);
+        __m256 invW = _mm256_div_ps(_mm256_set1_ps(1.0f), tw);
+        tx = _mm256_mul_ps(tx, invW);
+        ty = _mm256_mul_ps(ty, invW);
+        tz = _mm256_mul_ps(tz, invW);
+    }
+    px = tx;
+    py = ty;
+    pz = tz;
+}
+
+TARGET_AVX2
+static void transformPoints3Avx2(const float* m, const float* src, float* dst,
+                                 unsigned int begin, unsigned int end, bool project)
+{
+    __m256 row[16];
+    for(int j = 0; j < 16; ++j)
+        row[j] = _mm256_set1_ps(m[j]);
+
+    // lane k of x[] is at lane idx[k] after blending 3 registers, and back
+    const __m256i idxX = _mm256_setr_epi32(0, 3, 6, 1, 4, 7, 2, 5);
+    const __m256i idxY = _mm256_setr_epi32(1, 4, 7, 2, 5, 0, 3, 6);
+    const __m256i idxYInv = _mm256_setr_epi32(5, 0, 3, 6, 1, 4, 7, 2);
+    const __m256i idxZ = _mm256_setr_epi32(2, 5, 0, 3, 6, 1, 4, 7);
+
+    unsigned int i = begin;
+    for(; i + 8 <= end; i += 8)
+    {
+        // x0 y0 z0 x1 y1 z1 x2 y2 | z2 x3 y3 z3 x4 y4 z4 x5 | y5 z5 x6 y6 z6 x7 y7 z7
+        const float* p = src + 3 * i;
+        __m256 r0 = _mm256_loadu_ps(p);
+        __m256 r1 = _mm256_loadu_ps(p + 8);
+        __m256 r2 = _mm256_loadu_ps(p + 16);
+
+        __m256 px = _mm256_permutevar8x32_ps(_mm256_blend_ps(_mm256_blend_ps(r0, r1, 0x92), r2, 0x24), idxX);
+        __m256 py = _mm256_permutevar8x32_ps(_mm256_blend_ps(_mm256_blend_ps(r0, r1, 0x24), r2, 0x49), idxY);
+        __m256 pz = _mm256_permutevar8x32_ps(_mm256_blend_ps(_mm256_blend_ps(r0, r1, 0x49), r2, 0x92), idxZ);
+
+        transform8Avx2(row, px, py, pz, project);
+
+        px = _mm256_permutevar8x32_ps(px, idxX);
+        py = _mm256_permutevar8x32_ps(py, idxYInv);
+        pz = _mm256_permutevar8x32_ps(pz, idxZ);
+        float* q = dst + 3 * i;
+        _mm256_storeu_ps(q,      _mm256_blend_ps(_mm256_blend_ps(px, py, 0x92), pz, 0x24));
+        _mm256_storeu_ps(q + 8,  _mm256_blend_ps(_mm256_blend_ps(pz, px, 0x92), py, 0x24));
+        _mm256_storeu_ps(q + 16, _mm256_blend_ps(_mm256_blend_ps(py, pz, 0x92), px, 0x24));
+    }
+    transformPoints3Scalar(m, src, dst, i, end, project);
+}
+
+TARGET_AVX2
+static void transformPoints4Avx2(const float* m, const float* src, float* dst,
+                                 unsigned int begin, unsigned int end)
+{
+    const __m256 c0 = _mm256_broadcast_ps((const __m128*)m);
+    const __m256 c1 = _mm256_broadcast_ps((const __m128*)(m + 4));
+    const __m256 c2 = _mm256_broadcast_ps((const __m128*)(m + 8));
+    const __m256 c3 = _mm256_broadcast_ps((const __m128*)(m + 12));
+
+    unsigned int i = begin;
+    for(; i + 2 <= end; i += 2)
+    {
+        __m256 v = _mm256_loadu_ps(src + 4 * i);
+        __m256 r = _mm256_mul_ps(c0, _mm256_permute_ps(v, 0x00));
+        r = _mm256_add_ps(r, _mm256_mul_ps(c1, _mm256_permute_ps(v, 0x55)));
+        r = _mm256_add_ps(r, _mm256_mul_ps(c2, _mm256_permute_ps(v, 0xaa)));
+        r = _mm256_add_ps(r, _mm256_mul_ps(c3, _mm256_permute_ps(v, 0xff)));
+        _mm256_storeu_ps(dst + 4 * i, r);
+    }
+    transformPoints4Scalar(m, src, dst, i, end);
+}
+
+TARGET_AVX2
+static void transformPointsSoAAvx2(const float* m, const float* x, const float* y, const float* z,
+                                   float* dstX, float* dstY, float* dstZ,
+                                   unsigned int begin, unsigned int end, bool project)
+{
+    __m256 row[16];
+    for(int j = 0; j < 16; ++j)
+        row[j] = _mm256_set1_ps(m[j]);
+
+    unsigned int i = begin;
+    for(; i + 8 <= end; i += 8)
+    {
+        __m256 px = _mm256_loadu_ps(x + i);
+        __m256 py = _mm256_loadu_ps(y + i);
+        __m256 pz = _mm256_loadu_ps(z + i);
+        transform8Avx2(row, px, py, pz, project);
+        _mm256_storeu_ps(dstX + i, px);
+        _mm256_storeu_ps(dstY + i, py);
+        _mm256_storeu_ps(dstZ + i, pz);
+    }
+    transformPointsSoAScalar(m, x, y, z, dstX, dstY, dstZ, i, end, project);
+}
+
+// sin/cos of 8 angles(degree), same as sinCosScalar()
+TARGET_AVX2
+static inline void sinCos8Avx2(__m256 angle, __m256& sine, __m256& cosine)
+{
+    __m256 q = _mm256_round_ps(_mm256_mul_ps(angle, _mm256_set1_ps(1.0f / 90.0f)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m256i quadrant = _mm256_cvtps_epi32(q);
+    __m256 x = _mm256_mul_ps(_mm256_sub_ps(angle, _mm256_mul_ps(q, _mm256_set1_ps(90.0f))), _mm256_set1_ps(DEG2RAD));
+    __m256 x2 = _mm256_mul_ps(x, x);
+
+    __m256 s = _mm256_add_ps(_mm256_mul_ps(x2, _mm256_set1_ps(SIN_C2)), _mm256_set1_ps(SIN_C1));
+    s = _mm256_add_ps(_mm256_mul_ps(x2, s), _mm256_set1_ps(SIN_C0));
+    s = _mm256_add_ps(x, _mm256_mul_ps(_mm256_mul_ps(x, x2), s));
+    __m256 c = _mm256_add_ps(_mm256_mul_ps(x2, _mm256_set1_ps(COS_C2)), _mm256_set1_ps(COS_C1));
+    c = _mm256_add_ps(_mm256_mul_ps(x2, c), _mm256_set1_ps(COS_C0));
+    c = _mm256_add_ps(_mm256_sub_ps(_mm256_set1_ps(1.0f), _mm256_mul_ps(_mm256_set1_ps(0.5f), x2)), _mm256_mul_ps(_mm256_mul_ps(x2, x2), c));
+
+    __m256 swap = _mm256_castsi256_ps(_mm256_slli_epi32(quadrant, 31));
+    __m256 t = s;
+    s = _mm256_blendv_ps(s, c, swap);
+    c = _mm256_blendv_ps(c, t, swap);
+    __m256i signS = _mm256_slli_epi32(_mm256_srli_epi32(quadrant, 1), 31);
+    __m256i signC = _mm256_slli_epi32(_mm256_xor_si256(quadrant, _mm256_srli_epi32(quadrant, 1)), 31);
+    sine = _mm256_xor_ps(s, _mm256_castsi256_ps(signS));
+    cosine = _mm256_xor_ps(c, _mm256_castsi256_ps(signC));
+}
+
+// 2 columns per store: (col0 | col1), (col2 | col3)
+TARGET_AVX2
+static void buildTransformsAvx2(const Vector3* positions, const float* angles, const float* scales,
+                                float* matrices, unsigned int begin, unsigned int end)
+{
+    alignas(32) float sinScale[8];
+    alignas(32) float cosScale[8];
+
+    unsigned int i = begin;
+    for(; i + 8 <= end; i += 8)
+    {
+        __m256 s, c;
+        sinCos8Avx2(_mm256_loadu_ps(angles + i), s, c);
+        __m256 scale = _mm256_loadu_ps(scales + i);
+        _mm256_store_ps(sinScale, _mm256_mul_ps(s, scale));
+        _mm256_store_ps(cosScale, _mm256_mul_ps(c, scale));
+
+        float* m = matrices + 16 * i;
+        for(int j = 0; j < 8; ++j, m += 16)
+        {
+            const Vector3& p = positions[i + j];
+            _mm256_storeu_ps(m,     _mm256_setr_ps(cosScale[j], sinScale[j], 0, 0, -sinScale[j], cosScale[j], 0, 0));
+            _mm256_storeu_ps(m + 8, _mm256_setr_ps(0, 0, scales[i + j], 0, p.x, p.y, p.z, 1));
+        }
+    }
+    buildTransformsScalar(positions, angles, scales, matrices, i, end);
+}
+#endif
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// dispatchers
+///////////////////////////////////////////////////////////////////////////////
+static void transformPoints3(const Matrix4& matrix, const Vector3* src, Vector3* dst, unsigned int count,
+                             WorkPool* pool, bool project)
+{
+    if(count == 0)
+        return;
+
+    const float* m = matrix.get();
+    const float* s = &src[0].x;
+    float* d = &dst[0].x;
+    const int level = getTransformKernelLevel();
+    runRange(count, pool, [=](unsigned int begin, unsigned int end)
+    {
+#ifdef CPU_X86
+        if(level >= SIMD_AVX2)
+            transformPoints3Avx2(m, s, d, begin, end, project);
+        else if(level >= SIMD_SSE2)
+            transformPoints3Sse2(m, s, d, begin, end, project);
+        else
+#endif
+        transformPoints3Scalar(m, s, d, begin, end, project);
+    });
+}
+
+void transformPoints(const Matrix4& m, const Vector3* src, Vector3* dst, unsigned int count, WorkPool* pool)
+{
+    transformPoints3(m, src, dst, count, pool, false);
+}
+
+void projectPoints(const Matrix4& m, const Vector3* src, Vector3* dst, unsigned int count, WorkPool* pool)
+{
+    transformPoints3(m, src, dst, count, pool, true);
+}
+
+void transformPoints(const Matrix4& matrix, const Vector4* src, Vector4* dst, unsigned int count, WorkPool* pool)
+{
+    if(count == 0)
+        return;
+
+    const float* m = matrix.get();
+    const float* s = &src[0].x;
+    float* d = &dst[0].x;
+    const int level = getTransformKernelLevel();
+    runRange(count, pool, [=](unsigned int begin, unsigned int end)
+    {
+#ifdef CPU_X86
+        if(level >= SIMD_AVX2)
+            transformPoints4Avx2(m, s, d, begin, end);
+        else if(level >= SIMD_SSE2)
+            transformPoints4Sse2(m, s, d, begin, end);
+        else
+#endif
+        transformPoints4Scalar(m, s, d, begin, end);
+    });
+}
+
+static void transformPointsSoA(const Matrix4& matrix, const float* x, const float* y, const float* z,
+                               float* dstX, float* dstY, float* dstZ, unsigned int count,
+                               WorkPool* pool, bool project)
+{
+    if(count == 0)
+        return;
+
+    const float* m = matrix.get();
+    const int level = getTransformKernelLevel();
+    runRange(count, pool, [=](unsigned int begin, unsigned int end)
+    {
+#ifdef CPU_X86
+        if(level >= SIMD_AVX2)
+            transformPointsSoAAvx2(m, x, y, z, dstX, dstY, dstZ, begin, end, project);
+        else if(level >= SIMD_SSE2)
+            transformPointsSoASse2(m, x, y, z, dstX, dstY, dstZ, begin, end, project);
+        else
+#endif
+        transformPointsSoAScalar(m, x, y, z, dstX, dstY, dstZ, begin, end, project);
+    });
+}
+
+void transformPoints(const Matrix4& m, const float* x, const float* y, const float* z,
+                     float* dstX, float* dstY, float* dstZ, unsigned int count, WorkPool* pool)
+{
+    transformPointsSoA(m, x, y, z, dstX, dstY, dstZ, count, pool, false);
+}
+
+void projectPoints(const Matrix4& m, const float* x, const float* y, const float* z,
+                   float* dstX, float* dstY, float* dstZ, unsigned int count, WorkPool* pool)
+{
+    transformPointsSoA(m, x, y, z, dstX, dstY, dstZ, count, pool, true);
+}
+
+void buildTransforms(const Vector3* positions, const float* angles, const float* scales,
+                     float* matrices, unsigned int count, WorkPool* pool)
+{
+    if(count == 0)
+        return;
+
+    const int level = getTransformKernelLevel();
+    runRange(count, pool, [=](unsigned int begin, unsigned int end)
+    {
+#ifdef CPU_X86
+        if(level >= SIMD_AVX2)
+            buildTransformsAvx2(positions, angles, scales, matrices, begin, end);
+        else if(level >= SIMD_SSE2)
+            buildTransformsSse2(positions, angles, scales, matrices, begin, end);
+        else
+#endif
+        buildTransformsScalar(positions, angles, scales, matrices, begin, end);
+    }, BUILD_PARALLEL_COUNT);
+}
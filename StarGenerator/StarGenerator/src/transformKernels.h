@@ -0,0 +1,63 @@
+///////////////////////////////////////////////////////////////////////////////
+// transformKernels.h
+// ==================
+// vectorized kernels to transform arrays of 3D/4D points by a Matrix4
+// The points are either interleaved (Vector3 or Vector4 array) or separate
+// x[], y[] and z[] arrays. SSE2 or AVX2 version is selected at runtime by
+// detectSimdLevel(), and the scalar version is used on other CPUs.
+//
+// The results are same as Matrix4::operator*(Vector3/Vector4);
+// - transformPoints() = m * (x, y, z, 1) or m * (x, y, z, w)
+// - projectPoints()   = (x'/w', y'/w', z'/w') of m * (x, y, z, 1)
+// The AVX2 kernels may be fused to FMA by compiler (1 ulp difference).
+//
+// buildTransforms() builds the model matrices of N instances at once from the
+// arrays of position, angle(degree) on Z-axis and uniform scale. The matrix i
+// is T(position) * Rz(angle) * S(scale), same as
+// Matrix4().scale(s).rotateZ(a).translate(p), and it is written as 16 floats
+// (column-major) at matrices[16*i], ready for glBufferData() or
+// glUniformMatrix4fv(). sin/cos of 4 or 8 angles are computed at once by a
+// polynomial after reducing the angle in degree, accurate to about 1e-7.
+//
+// The arrays of count >= TRANSFORM_PARALLEL_COUNT are split into the threads
+// of WorkPool; pool=0 uses the shared pool. Called from a worker of the pool,
+// it runs serially. dst may be same as src (in-place), but must not overlap
+// partially.
+//
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TRANSFORM_KERNELS_H
+#define TRANSFORM_KERNELS_H
+
+#include "Vectors.h"
+#include "Matrices.h"
+
+class WorkPool;
+
+// # of points/matrices to split into threads
+const unsigned int TRANSFORM_PARALLEL_COUNT = 32768;
+const unsigned int BUILD_PARALLEL_COUNT = 8192;
+
+// interleaved
+void transformPoints(const Matrix4& m, const Vector3* src, Vector3* dst, unsigned int count, WorkPool* pool=0);
+void transformPoints(const Matrix4& m, const Vector4* src, Vector4* dst, unsigned int count, WorkPool* pool=0);
+void projectPoints(const Matrix4& m, const Vector3* src, Vector3* dst, unsigned int count, WorkPool* pool=0);
+
+// separate
+void transformPoints(const Matrix4& m, const float* x, const float* y, const float* z,
+                     float* dstX, float* dstY, float* dstZ, unsigned int count, WorkPool* pool=0);
+void projectPoints(const Matrix4& m, const float* x, const float* y, const float* z,
+                   float* dstX, float* dstY, float* dstZ, unsigned int count, WorkPool* pool=0);
+
+// TRS matrices, matrices must have 16 * count floats
+void buildTransforms(const Vector3* positions, const float* angles, const float* scales,
+                     float* matrices, unsigned int count, WorkPool* pool=0);
+
+// select the kernels, it cannot be higher than detectSimdLevel()
+// It is for comparing the kernels, the default is the highest level.
+void setTransformKernelLevel(int level);
+int getTransformKernelLevel();
+
+#endif